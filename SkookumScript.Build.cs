@@ -67,8 +67,14 @@ public class SkookumScript : ModuleRules
         break;
     }
 
+    // Dedicated servers (other than Debug) run lean: built like Shipping so the remote
+    // SkookumIDE connection and all per-expression debug hooks are compiled out
+    var bLeanServer = Target.Type == TargetRules.TargetType.Server
+      && Target.Configuration != UnrealTargetConfiguration.Debug
+      && Target.Configuration != UnrealTargetConfiguration.DebugGame;
+
     // NOTE: All modules inside the SkookumScript plugin folder must use the exact same definitions!
-    switch (Target.Configuration)
+    switch (bLeanServer ? UnrealTargetConfiguration.Shipping : Target.Configuration)
     {
       case UnrealTargetConfiguration.Debug:
       case UnrealTargetConfiguration.DebugGame:
@@ -88,6 +94,13 @@ public class SkookumScript : ModuleRules
         break;
     }
 
+    // Also makes the runtime leave out its IDE connection, profiler, telemetry and error
+    // dialogs explicitly rather than relying on the Shipping definitions alone
+    if (bLeanServer)
+    {
+      Definitions.Add("SK_LEAN_SERVER");
+    }
+
     // Determine if monolithic build
     var bIsMonolithic = (!Target.bIsMonolithic.HasValue || (bool)Target.bIsMonolithic); // Assume monolithic if not specified
 
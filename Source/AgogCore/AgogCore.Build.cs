@@ -93,8 +93,14 @@ public class AgogCore : ModuleRules
         break;
     }
 
+    // Dedicated servers (other than Debug) run lean: built like Shipping so the remote
+    // SkookumIDE connection and all per-expression debug hooks are compiled out
+    var bLeanServer = Target.Type == TargetRules.TargetType.Server
+      && Target.Configuration != UnrealTargetConfiguration.Debug
+      && Target.Configuration != UnrealTargetConfiguration.DebugGame;
+
     // NOTE: All modules inside the SkookumScript plugin folder must use the exact same definitions!
-    switch (Target.Configuration)
+    switch (bLeanServer ? UnrealTargetConfiguration.Shipping : Target.Configuration)
     {
       case UnrealTargetConfiguration.Debug:
       case UnrealTargetConfiguration.DebugGame:
@@ -0,0 +1,86 @@
+//=======================================================================================
+// Agog Labs C++ library.
+// Copyright (c) 2016 Agog Labs Inc.,
+// All rights reserved.
+//
+//  ADeferRelease class definition module
+// Notes:
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include <AgogCore/AgogCore.hpp> // Always include AgogCore first (as some builds require a designated precompiled header)
+#include <AgogCore/ADeferRelease.hpp>
+
+
+//=======================================================================================
+// Class Data
+//=======================================================================================
+
+ADeferRelease::Entry * ADeferRelease::ms_entries_a      = nullptr;
+uint32_t               ADeferRelease::ms_count          = 0u;
+uint32_t               ADeferRelease::ms_size           = 0u;
+uint32_t               ADeferRelease::ms_count_max      = 0u;
+uint32_t               ADeferRelease::ms_released_total = 0u;
+
+
+//=======================================================================================
+// Class Methods
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+// Cleans up previously posted objects.
+// Returns:    number of objects released
+// Arg         max_count - maximum number of posted objects to release during this call
+// Notes:      Generally called at the end of a main loop or frame update.
+// Modifiers:   static
+uint32_t ADeferRelease::release(uint32_t max_count)
+  {
+  uint32_t released_count = 0u;
+
+  while (ms_count && released_count < max_count)
+    {
+    // Copy before calling since the release may post more objects and grow the array
+    Entry entry = ms_entries_a[--ms_count];
+
+    (entry.m_release_f)(entry.m_obj_p);
+    released_count++;
+    }
+
+  ms_released_total += released_count;
+
+  return released_count;
+  }
+
+//---------------------------------------------------------------------------------------
+// Cleans up all previously posted objects and any objects they release in turn.
+// Notes:      Must be called before the code the release functions depend upon goes
+//             away - e.g. before unloading a program or shutting down.
+// Modifiers:   static
+void ADeferRelease::release_all()
+  {
+  while (ms_count)
+    {
+    release(ms_count);
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Frees the queue memory
+// Notes:      The queue must have been emptied with release_all() while the objects
+//             could still be released.
+// Modifiers:   static
+void ADeferRelease::deinitialize()
+  {
+  A_ASSERTX(ms_count == 0u, "ADeferRelease still has objects pending - call release_all() first!");
+
+  if (ms_entries_a)
+    {
+    AgogCore::get_app_info()->free(ms_entries_a);
+    ms_entries_a = nullptr;
+    ms_size      = 0u;
+    }
+  }
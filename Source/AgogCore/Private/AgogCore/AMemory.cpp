@@ -180,6 +180,36 @@ AMemoryStats::~AMemoryStats()
     }
   }
 
+//---------------------------------------------------------------------------------------
+// Returns:    number of different allocation types tracked so far - always 0 unless
+//             tracking with Track_type
+uint32_t AMemoryStats::get_type_count() const
+  {
+  return m_info_list_p ? m_info_list_p->get_length() : 0u;
+  }
+
+//---------------------------------------------------------------------------------------
+// Gets the accumulated memory usage of a single allocation type - so it can be exported
+// elsewhere rather than just printed with print_summary().
+// Arg         idx - index of type - must be less than get_type_count()
+// Arg         type_cstr_pp - address to store name of type
+// Arg         alloc_count_p - address to store number of allocations of this type
+// Arg         bytes_actual_p - address to store number of bytes actually allocated for
+//             this type - including any slack added by the app's allocator
+void AMemoryStats::get_type_info(
+  uint32_t      idx,
+  const char ** type_cstr_pp,
+  uint32_t *    alloc_count_p,
+  uint32_t *    bytes_actual_p
+  ) const
+  {
+  const AMemoryInfo * info_p = m_info_list_p->get_array()[idx];
+
+  *type_cstr_pp   = info_p->m_type_cstr_p;
+  *alloc_count_p  = info_p->m_alloc_count;
+  *bytes_actual_p = info_p->get_total_size_actual();
+  }
+
 //---------------------------------------------------------------------------------------
 // Sums up memory usage statistics and prints out a summary to the default
 //             output.
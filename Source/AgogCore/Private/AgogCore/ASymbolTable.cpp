@@ -21,6 +21,7 @@
 #endif
 #include <AgogCore/AStringRef.hpp>
 #include <AgogCore/AString.hpp>
+#include <AgogCore/APArray.hpp>
 
 
 //=======================================================================================
@@ -328,8 +329,12 @@ void ASymbolTable::merge_binary(const void ** binary_pp)
   // 4 bytes - number of symbols
   uint32_t length = A_BYTE_STREAM_UI32_INC(binary_pp);
 
-  // Assume that there will be no overlap
-  m_sym_refs.ensure_size(init_length + length);
+  // New symbols are gathered and merged in with one pass at the end rather than being
+  // inserted one at a time - which moved the rest of the table for each and made loading
+  // large symbol tables quadratic.  Since the binary is in symbol id order so are they.
+  APArray<ASymbolRef> new_syms;
+
+  new_syms.ensure_size(length);
 
 
   //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -347,11 +352,27 @@ void ASymbolTable::merge_binary(const void ** binary_pp)
     str_len = A_BYTE_STREAM_UI8_INC(binary_pp);
 
     // n bytes - string
-    symbol_reference(sym_id, (const char *)*binary_pp, str_len, ATerm_short);
+    if (sym_id != ASymbol_id_null)
+      {
+      if (m_sym_refs.find(sym_id))
+        {
+        // Already present - just check for a name collision
+        symbol_reference(sym_id, (const char *)*binary_pp, str_len, ATerm_short);
+        }
+      else
+        {
+        new_syms.append(*ASymbolRef::pool_new(
+          AStringRef::pool_new_copy((const char *)*binary_pp, str_len),
+          sym_id));
+        }
+      }
+
     (*(uint8_t **)binary_pp) += str_len;
 
     length--;
     }
+
+  m_sym_refs.append_all(const_cast<const ASymbolRef **>(new_syms.get_array()), new_syms.get_length(), true);
   }
 
 
@@ -17,12 +17,15 @@
 
 #include <AgogCore/AgogCore.hpp> // Always include AgogCore first (as some builds require a designated precompiled header)
 #include <AgogCore/ADeferFunc.hpp>
+#include <AgogCore/ADeferRelease.hpp>
 #include <AgogCore/ARandom.hpp>
 #include <AgogCore/AStringRef.hpp>
 #include <AgogCore/AString.hpp>
 #include <AgogCore/ASymbolTable.hpp>
 #include <stdio.h>     // Uses: _vsnprintf(), va_list
 #include <stdarg.h>    // Uses: va_start, va_end
+#include <mutex>       // Uses: std::mutex
+#include <string.h>    // Uses: memset()
 
 
 // These files are not included elsewhere in the AgogCore library, so they are included
@@ -35,6 +38,7 @@
 #include <AgogCore/AIndexPointer.hpp>
 #include <AgogCore/AList.hpp>
 #include <AgogCore/AMethodArg.hpp>
+#include <AgogCore/AObjReusePoolConcurrent.hpp>
 #include <AgogCore/APCompactArray.hpp>
 
 #if defined(A_PLAT_PC) && defined(A_EXTRA_CHECK)
@@ -235,6 +239,7 @@ namespace AgogCore
     {
     // Deinitialize subsystems
     ADeferFunc::ms_deferred_funcs.free_all_compact();
+    ADeferRelease::deinitialize();
     ADebug::deinitialize();
     ASymbolTable::deinitialize();
     AString::deinitialize();
@@ -260,6 +265,135 @@ namespace AgogCore
     s_app_info_p = app_info_p;
     }
 
+  namespace
+  {
+
+  //---------------------------------------------------------------------------------------
+  // Thread slots in use and functions to call when a thread gives up its slot
+  struct AThreadSlots
+    {
+    enum
+      {
+      // Slots beyond this are never handed out again - plenty since per-thread data is
+      // typically only kept for far fewer threads
+      Recycle_max = 256
+      };
+
+    std::mutex        m_mutex;
+    uint32_t          m_used_bits[Recycle_max / 32];
+    uint32_t          m_overflow_count;
+    AThreadExitFunc * m_exit_funcs_p;
+
+    AThreadSlots() : m_overflow_count(0u), m_exit_funcs_p(nullptr) { ::memset(m_used_bits, 0, sizeof(m_used_bits)); }
+
+    static AThreadSlots & get() { static AThreadSlots s_slots; return s_slots; }
+
+    //-------------------------------------------------------------------------------------
+    // Hands out the lowest free slot
+    uint32_t acquire()
+      {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      for (uint32_t word_idx = 0u; word_idx < Recycle_max / 32; ++word_idx)
+        {
+        uint32_t free_bits = ~m_used_bits[word_idx];
+        if (free_bits)
+          {
+          uint32_t bit_idx = 0u;
+          while (!(free_bits & (1u << bit_idx))) { ++bit_idx; }
+          m_used_bits[word_idx] |= 1u << bit_idx;
+          return word_idx * 32u + bit_idx;
+          }
+        }
+
+      return Recycle_max + m_overflow_count++;
+      }
+
+    //-------------------------------------------------------------------------------------
+    // Lets registered functions clean up after an exiting thread and frees its slot
+    void release(uint32_t slot)
+      {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      for (AThreadExitFunc * exit_func_p = m_exit_funcs_p; exit_func_p; exit_func_p = exit_func_p->m_next_p)
+        {
+        (exit_func_p->m_func_p)(exit_func_p->m_user_p, slot);
+        }
+
+      if (slot < Recycle_max)
+        {
+        m_used_bits[slot / 32u] &= ~(1u << (slot % 32u));
+        }
+      }
+    };
+
+  //---------------------------------------------------------------------------------------
+  // Set once the slot of the calling thread was given back. Other thread_local objects
+  // may still be destroyed afterwards on the same thread and free memory - their slot
+  // may already belong to another thread by then. Trivially destructible so it stays
+  // readable until the thread is gone.
+  thread_local bool s_slot_released = false;
+
+  //---------------------------------------------------------------------------------------
+  // Owns the slot of a thread - gives it back when the thread exits
+  struct AThreadSlotOwner
+    {
+    uint32_t m_slot;
+
+    AThreadSlotOwner() : m_slot(AThreadSlots::get().acquire()) {}
+    ~AThreadSlotOwner() { s_slot_released = true; AThreadSlots::get().release(m_slot); }
+    };
+
+  } // End unnamed namespace
+
+  //---------------------------------------------------------------------------------------
+  // Get index of calling thread - e.g. to look up per-thread data without a TLS lookup
+  // per data structure. Defined here rather than inline so all modules agree on the index.
+  // Returns:    slot index or ThreadSlot_none once the slot was given back on thread exit
+  uint32_t get_thread_slot()
+    {
+    // Do not touch the already destroyed owner or create a new one
+    if (s_slot_released)
+      {
+      return ThreadSlot_none;
+      }
+
+    static thread_local AThreadSlotOwner s_slot_owner;
+
+    return s_slot_owner.m_slot;
+    }
+
+  //---------------------------------------------------------------------------------------
+  // Registers function to call on each thread that obtained a slot right before it exits
+  // Notes:      exit_func_p must stay valid until unregister_thread_exit_func() is called.
+  //             The function is called with an internal lock held so it must not call
+  //             get_thread_slot() or (un)register exit functions itself.
+  void register_thread_exit_func(AThreadExitFunc * exit_func_p)
+    {
+    AThreadSlots & slots = AThreadSlots::get();
+    std::lock_guard<std::mutex> lock(slots.m_mutex);
+
+    exit_func_p->m_next_p = slots.m_exit_funcs_p;
+    slots.m_exit_funcs_p = exit_func_p;
+    }
+
+  //---------------------------------------------------------------------------------------
+  // Unregisters function previously registered with register_thread_exit_func()
+  void unregister_thread_exit_func(AThreadExitFunc * exit_func_p)
+    {
+    AThreadSlots & slots = AThreadSlots::get();
+    std::lock_guard<std::mutex> lock(slots.m_mutex);
+
+    for (AThreadExitFunc ** link_pp = &slots.m_exit_funcs_p; *link_pp; link_pp = &(*link_pp)->m_next_p)
+      {
+      if (*link_pp == exit_func_p)
+        {
+        *link_pp = exit_func_p->m_next_p;
+        break;
+        }
+      }
+    }
+
   }
 
 //---------------------------------------------------------------------------------------
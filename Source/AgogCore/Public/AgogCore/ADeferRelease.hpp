@@ -0,0 +1,111 @@
+//=======================================================================================
+// Agog Labs C++ library.
+// Copyright (c) 2016 Agog Labs Inc.,
+// All rights reserved.
+//
+//  ADeferRelease class declaration header
+// Notes:
+//=======================================================================================
+
+#pragma once
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include <AgogCore/AgogCore.hpp>
+
+
+//=======================================================================================
+// Global Structures
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+// Queue of objects whose clean up has been put off - similar in concept to
+// ARefCountMix<>::dereference_delay() but the clean up happens later in one place.
+//
+// Letting go of an object (e.g. an object with many data members or a long list) may
+// clean up a large graph of objects right away.  Code that knows it is about to let go
+// of such an object can post() it here instead and release() then cleans up a given
+// number of posted objects at a time - so the work of many such objects can be spread
+// over several frames.  Objects are released last in, first out.
+//
+// Not thread safe - meant to be used from the main/game thread only.
+class A_API ADeferRelease
+  {
+  public:
+
+  // Nested Types
+
+    // Function that performs the actual clean up of an object
+    typedef void (* tReleaseFunc)(void * obj_p);
+
+  // Class Methods
+
+    static void     post(void * obj_p, tReleaseFunc release_f);
+    static uint32_t release(uint32_t max_count);
+    static void     release_all();
+    static void     deinitialize();
+
+    static uint32_t get_length()         { return ms_count; }
+    static uint32_t get_length_max()     { return ms_count_max; }
+    static uint32_t get_released_total() { return ms_released_total; }
+
+  protected:
+
+  // Nested Types
+
+    struct Entry
+      {
+      void *       m_obj_p;
+      tReleaseFunc m_release_f;
+      };
+
+  // Class Data Members
+
+    // Stack of objects to release
+    static Entry *  ms_entries_a;
+    static uint32_t ms_count;
+    static uint32_t ms_size;
+
+    // Statistics
+    static uint32_t ms_count_max;
+    static uint32_t ms_released_total;
+
+  };
+
+
+//=======================================================================================
+// Inline Functions
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+// Remembers an object to be cleaned up later by release()
+// Arg         obj_p - object to release
+// Arg         release_f - function to call with obj_p to clean it up
+inline void ADeferRelease::post(void * obj_p, tReleaseFunc release_f)
+  {
+  if (ms_count == ms_size)
+    {
+    uint32_t new_size  = ms_size ? (ms_size << 1u) : 256u;
+    Entry *  entries_a = static_cast<Entry *>(AgogCore::get_app_info()->malloc(new_size * sizeof(Entry), "ADeferRelease"));
+
+    if (ms_entries_a)
+      {
+      ::memcpy(entries_a, ms_entries_a, ms_count * sizeof(Entry));
+      AgogCore::get_app_info()->free(ms_entries_a);
+      }
+
+    ms_entries_a = entries_a;
+    ms_size      = new_size;
+    }
+
+  Entry & entry = ms_entries_a[ms_count++];
+  entry.m_obj_p     = obj_p;
+  entry.m_release_f = release_f;
+
+  if (ms_count > ms_count_max)
+    {
+    ms_count_max = ms_count;
+    }
+  }
@@ -73,6 +73,8 @@ struct A_API AMemoryStats
     ~AMemoryStats();
 
     uint32_t print_summary(uint32_t * debug_bytes_p = nullptr);
+    uint32_t get_type_count() const;
+    void     get_type_info(uint32_t idx, const char ** type_cstr_pp, uint32_t * alloc_count_p, uint32_t * bytes_actual_p) const;
     void     track_memory(const char * type_cstr_p, uint32_t size_sizeof, uint32_t size_debug = 0u, uint32_t size_dynamic_needed = 0u, uint32_t size_dynamic = 0u, uint32_t alloc_count = 1u);
     void     track_memory_shared(const char * type_cstr_p, uint32_t size_static, uint32_t size_dynamic_needed = 0u, uint32_t size_dynamic = 0u);
 
@@ -0,0 +1,434 @@
+//=======================================================================================
+// Agog Labs C++ library.
+// Copyright (c) 2000 Agog Labs Inc.,
+// All rights reserved.
+//
+//  Thread-safe Object Reuse Pool class template
+// Notes:
+//=======================================================================================
+
+#pragma once
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include <AgogCore/AObjReusePool.hpp>
+#include <mutex>
+#include <string.h>      // Uses: memset()
+
+//=======================================================================================
+// Global Macros / Defines
+//=======================================================================================
+
+#ifndef AORPOOL_CONCURRENT_THREAD_SLOTS
+  // Number of threads that can have their own magazines
+  // Any threads beyond that go straight to the depot for each object
+  #define AORPOOL_CONCURRENT_THREAD_SLOTS 32
+#endif
+
+
+//=======================================================================================
+// Global Structures
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+// Notes    Thread-safe variant of AObjReusePool - opt-in, since AObjReusePool is faster
+//          when all objects are created and destroyed on the same thread.
+//
+//          Each thread allocates from and recycles into its own pair of "magazines" -
+//          short lists of free objects - without any synchronization. Only when both of
+//          its magazines are empty (allocate) or both are full (recycle) does a thread
+//          lock the shared depot and trade one magazine for a full or empty one.
+//          The depot itself is backed by a regular AObjReusePool that grows as needed.
+//
+//          Objects allocated on one thread may be recycled on any other thread.
+//          When a thread exits, its magazines are returned to the depot automatically
+//          and its slot (see AgogCore::get_thread_slot()) is reused by later threads.
+//          Objects recycled by thread_local destructors running after that go straight
+//          to the depot.
+//          empty() must only be called when no other thread is using the pool.
+//
+//          Just like for AObjReusePool, _ObjectType must provide get_pool_unused_next().
+// Arg      _ObjectType - the class/type of objects stored in the pool.
+// Examples:
+//   AObjReusePoolConcurrent<SkInstance> pool(1024, 256);
+//   SkInstance * instance_p = pool.allocate(); // Any thread
+//   pool.recycle(instance_p);                  // Any thread
+template<class _ObjectType>
+class AObjReusePoolConcurrent : protected AObjReusePool<_ObjectType>
+  {
+  public:
+
+  // Common types
+
+    // Local shorthand for templates
+    typedef AObjReusePool<_ObjectType>            tObjReusePool;
+    typedef AObjReusePoolConcurrent<_ObjectType>  tObjReusePoolConcurrent;
+
+  // Common Methods
+
+    AObjReusePoolConcurrent(uint32_t initial_size, uint32_t expand_size, uint32_t magazine_size = 64u);
+    ~AObjReusePoolConcurrent();
+
+  // Accessor Methods
+
+    uint32_t get_initial_size() const   { return this->m_initial_size; }
+    uint32_t get_expand_size() const    { return this->m_expand_size; }
+    uint32_t get_magazine_size() const  { return m_magazine_size; }
+
+  // Modifying Methods
+
+    _ObjectType * allocate();
+    void          recycle(_ObjectType * obj_p);
+
+    void          flush_thread_cache();
+    void          empty();
+
+  protected:
+
+  // Types
+
+    typedef typename tObjReusePool::AllocObject AllocObject;
+
+    // Singly linked list of free objects
+    struct Magazine
+      {
+      AllocObject * m_first_p;
+      uint32_t      m_count;
+      Magazine *    m_next_p; // Next magazine while stored in the depot
+
+      void push(AllocObject * obj_p)  { *obj_p->get_pool_unused_next() = m_first_p; m_first_p = obj_p; ++m_count; }
+      AllocObject * pop()             { AllocObject * obj_p = m_first_p; m_first_p = static_cast<AllocObject *>(*obj_p->get_pool_unused_next()); --m_count; return obj_p; }
+      };
+
+    // Magazines owned by a single thread
+    // Cache line aligned so threads do not contend over neighboring entries
+    struct alignas(64) ThreadCache
+      {
+      Magazine * m_loaded_p;    // Magazine currently allocated from/recycled to
+      Magazine * m_previous_p;  // Always either full or empty
+      };
+
+  // Methods
+
+    ThreadCache * get_thread_cache();
+    void          flush_thread_slot(uint32_t slot);
+    static void   on_thread_exit(void * user_p, uint32_t thread_slot);
+    Magazine *    depot_pop_full();
+    Magazine *    depot_pop_empty();
+    void          depot_push_empty(Magazine * magazine_p);
+    void          depot_drain(Magazine * magazine_p);
+
+  // Data Members
+
+    // Number of objects per magazine
+    uint32_t m_magazine_size;
+
+    // Depot of magazines to trade with - all protected by m_depot_mutex
+    // Also protects the base AObjReusePool
+    Magazine *  m_depot_full_p;
+    Magazine *  m_depot_empty_p;
+    std::mutex  m_depot_mutex;
+
+    // Magazines of each thread indexed by AgogCore::get_thread_slot()
+    ThreadCache m_thread_caches[AORPOOL_CONCURRENT_THREAD_SLOTS];
+
+    // Returns magazines of exiting threads to the depot
+    AgogCore::AThreadExitFunc m_thread_exit_func;
+
+  };  // AObjReusePoolConcurrent
+
+
+
+//=======================================================================================
+// Methods
+//=======================================================================================
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Common Methods
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+//---------------------------------------------------------------------------------------
+// Constructor
+// Returns:    itself
+// Arg         initial_size - initial object population for the reuse pool
+// Arg         expand_size - additional number of objects to allocate if all the objects
+//             in the reuse pool are in use and more objects are required.
+// Arg         magazine_size - number of objects each thread grabs from/returns to the
+//             depot at once
+template<class _ObjectType>
+inline AObjReusePoolConcurrent<_ObjectType>::AObjReusePoolConcurrent(
+  uint32_t initial_size,
+  uint32_t expand_size,
+  uint32_t magazine_size
+  ) :
+  tObjReusePool(initial_size, expand_size),
+  m_magazine_size(magazine_size),
+  m_depot_full_p(nullptr),
+  m_depot_empty_p(nullptr)
+  {
+  A_ASSERTX(magazine_size > 0u, "Magazine size must be at least one object.");
+  ::memset(m_thread_caches, 0, sizeof(m_thread_caches));
+
+  m_thread_exit_func.m_func_p = &on_thread_exit;
+  m_thread_exit_func.m_user_p = this;
+  AgogCore::register_thread_exit_func(&m_thread_exit_func);
+  }
+
+//---------------------------------------------------------------------------------------
+// Destructor
+// Notes:      Like AObjReusePool, memory is only released via empty()
+template<class _ObjectType>
+inline AObjReusePoolConcurrent<_ObjectType>::~AObjReusePoolConcurrent()
+  {
+  AgogCore::unregister_thread_exit_func(&m_thread_exit_func);
+  }
+
+//---------------------------------------------------------------------------------------
+// Retrieves a previously allocated object from the pool - may be called from any thread.
+// Returns:    a dynamic object
+// See:        recycle()
+template<class _ObjectType>
+_ObjectType * AObjReusePoolConcurrent<_ObjectType>::allocate()
+  {
+  ThreadCache * cache_p = get_thread_cache();
+  if (!cache_p)
+    {
+    // No magazines for this thread - get object straight from depot
+    std::lock_guard<std::mutex> lock(m_depot_mutex);
+    return tObjReusePool::allocate();
+    }
+
+  Magazine * magazine_p = cache_p->m_loaded_p;
+  if (!magazine_p->m_count)
+    {
+    if (cache_p->m_previous_p->m_count)
+      {
+      // Previous one is full, use that
+      cache_p->m_loaded_p = cache_p->m_previous_p;
+      cache_p->m_previous_p = magazine_p;
+      }
+    else
+      {
+      // Both are empty - trade one for a full magazine
+      std::lock_guard<std::mutex> lock(m_depot_mutex);
+      depot_push_empty(cache_p->m_previous_p);
+      cache_p->m_previous_p = magazine_p;
+      cache_p->m_loaded_p = depot_pop_full();
+      }
+    magazine_p = cache_p->m_loaded_p;
+    }
+
+  return magazine_p->pop();
+  }
+
+//---------------------------------------------------------------------------------------
+// Returns an object to the pool - may be called from any thread, including a thread
+// different from the one that allocated the object.
+// Arg         obj_p - pointer to object to put back into the pool.
+// See:        allocate()
+template<class _ObjectType>
+void AObjReusePoolConcurrent<_ObjectType>::recycle(_ObjectType * obj_p)
+  {
+  ThreadCache * cache_p = get_thread_cache();
+  if (!cache_p)
+    {
+    // No magazines for this thread - return object straight to depot
+    std::lock_guard<std::mutex> lock(m_depot_mutex);
+    tObjReusePool::recycle(obj_p);
+    return;
+    }
+
+  Magazine * magazine_p = cache_p->m_loaded_p;
+  if (magazine_p->m_count >= m_magazine_size)
+    {
+    if (cache_p->m_previous_p->m_count < m_magazine_size)
+      {
+      // Previous one is empty, use that
+      cache_p->m_loaded_p = cache_p->m_previous_p;
+      cache_p->m_previous_p = magazine_p;
+      }
+    else
+      {
+      // Both are full - trade one for an empty magazine
+      std::lock_guard<std::mutex> lock(m_depot_mutex);
+      Magazine * full_p = cache_p->m_previous_p;
+      full_p->m_next_p = m_depot_full_p;
+      m_depot_full_p = full_p;
+      cache_p->m_previous_p = magazine_p;
+      cache_p->m_loaded_p = depot_pop_empty();
+      }
+    magazine_p = cache_p->m_loaded_p;
+    }
+
+  magazine_p->push(static_cast<AllocObject *>(obj_p));
+  }
+
+//---------------------------------------------------------------------------------------
+// Returns all objects cached by the calling thread to the depot.
+// Call before a worker thread exits or goes idle for a long time.
+// Notes:      Happens automatically when a thread exits
+template<class _ObjectType>
+inline void AObjReusePoolConcurrent<_ObjectType>::flush_thread_cache()
+  {
+  flush_thread_slot(AgogCore::get_thread_slot());
+  }
+
+//---------------------------------------------------------------------------------------
+// Returns all objects cached for the given thread slot to the depot
+template<class _ObjectType>
+void AObjReusePoolConcurrent<_ObjectType>::flush_thread_slot(uint32_t slot)
+  {
+  if (slot < AORPOOL_CONCURRENT_THREAD_SLOTS)
+    {
+    ThreadCache & cache = m_thread_caches[slot];
+    if (cache.m_loaded_p)
+      {
+      std::lock_guard<std::mutex> lock(m_depot_mutex);
+      depot_drain(cache.m_loaded_p);
+      depot_drain(cache.m_previous_p);
+      cache.m_loaded_p = nullptr;
+      cache.m_previous_p = nullptr;
+      }
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Called on a thread right before it exits - so its magazines are not lost and its
+// slot can be used by another thread
+template<class _ObjectType>
+void AObjReusePoolConcurrent<_ObjectType>::on_thread_exit(void * user_p, uint32_t thread_slot)
+  {
+  static_cast<tObjReusePoolConcurrent *>(user_p)->flush_thread_slot(thread_slot);
+  }
+
+//---------------------------------------------------------------------------------------
+// Returns all cached objects to the backing pool and frees all memory
+// Notes:      Must only be called when no other thread is using this pool
+template<class _ObjectType>
+void AObjReusePoolConcurrent<_ObjectType>::empty()
+  {
+  std::lock_guard<std::mutex> lock(m_depot_mutex);
+
+  // Gather magazines of all threads
+  for (uint32_t slot = 0u; slot < AORPOOL_CONCURRENT_THREAD_SLOTS; ++slot)
+    {
+    ThreadCache & cache = m_thread_caches[slot];
+    if (cache.m_loaded_p)
+      {
+      depot_drain(cache.m_loaded_p);
+      depot_drain(cache.m_previous_p);
+      cache.m_loaded_p = nullptr;
+      cache.m_previous_p = nullptr;
+      }
+    }
+
+  // Gather full magazines stored in depot
+  while (m_depot_full_p)
+    {
+    Magazine * magazine_p = m_depot_full_p;
+    m_depot_full_p = magazine_p->m_next_p;
+    depot_drain(magazine_p);
+    }
+
+  // Now all magazines are empty - free them
+  while (m_depot_empty_p)
+    {
+    Magazine * magazine_p = m_depot_empty_p;
+    m_depot_empty_p = magazine_p->m_next_p;
+    AgogCore::get_app_info()->free(magazine_p);
+    }
+
+  tObjReusePool::empty();
+  }
+
+//---------------------------------------------------------------------------------------
+// Returns magazines of calling thread, lazily creating them on first use
+// Returns:    magazines or nullptr if this thread has no slot (or gave it back already)
+template<class _ObjectType>
+inline typename AObjReusePoolConcurrent<_ObjectType>::ThreadCache * AObjReusePoolConcurrent<_ObjectType>::get_thread_cache()
+  {
+  uint32_t slot = AgogCore::get_thread_slot();
+  if (slot >= AORPOOL_CONCURRENT_THREAD_SLOTS)
+    {
+    return nullptr;
+    }
+
+  ThreadCache * cache_p = &m_thread_caches[slot];
+  if (!cache_p->m_loaded_p)
+    {
+    std::lock_guard<std::mutex> lock(m_depot_mutex);
+    cache_p->m_loaded_p = depot_pop_empty();
+    cache_p->m_previous_p = depot_pop_empty();
+    }
+
+  return cache_p;
+  }
+
+//---------------------------------------------------------------------------------------
+// Gets a full magazine from the depot - filling one from the backing pool if there is none
+// Notes:      m_depot_mutex must be locked
+template<class _ObjectType>
+typename AObjReusePoolConcurrent<_ObjectType>::Magazine * AObjReusePoolConcurrent<_ObjectType>::depot_pop_full()
+  {
+  Magazine * magazine_p = m_depot_full_p;
+  if (magazine_p)
+    {
+    m_depot_full_p = magazine_p->m_next_p;
+    return magazine_p;
+    }
+
+  magazine_p = depot_pop_empty();
+  for (uint32_t i = 0u; i < m_magazine_size; ++i)
+    {
+    magazine_p->push(static_cast<AllocObject *>(tObjReusePool::allocate()));
+    }
+
+  return magazine_p;
+  }
+
+//---------------------------------------------------------------------------------------
+// Gets an empty magazine from the depot - creating one if there is none
+// Notes:      m_depot_mutex must be locked
+template<class _ObjectType>
+typename AObjReusePoolConcurrent<_ObjectType>::Magazine * AObjReusePoolConcurrent<_ObjectType>::depot_pop_empty()
+  {
+  Magazine * magazine_p = m_depot_empty_p;
+  if (magazine_p)
+    {
+    m_depot_empty_p = magazine_p->m_next_p;
+    }
+  else
+    {
+    magazine_p = static_cast<Magazine *>(AgogCore::get_app_info()->malloc(sizeof(Magazine), "AObjReusePoolConcurrent::Magazine"));
+    A_VERIFY_MEMORY(magazine_p != nullptr, tObjReusePoolConcurrent);
+    magazine_p->m_first_p = nullptr;
+    magazine_p->m_count = 0u;
+    }
+
+  return magazine_p;
+  }
+
+//---------------------------------------------------------------------------------------
+// Stores an empty magazine in the depot
+// Notes:      m_depot_mutex must be locked
+template<class _ObjectType>
+inline void AObjReusePoolConcurrent<_ObjectType>::depot_push_empty(Magazine * magazine_p)
+  {
+  magazine_p->m_next_p = m_depot_empty_p;
+  m_depot_empty_p = magazine_p;
+  }
+
+//---------------------------------------------------------------------------------------
+// Returns all objects of a magazine to the backing pool and stores it as empty
+// Notes:      m_depot_mutex must be locked
+template<class _ObjectType>
+void AObjReusePoolConcurrent<_ObjectType>::depot_drain(Magazine * magazine_p)
+  {
+  while (magazine_p->m_count)
+    {
+    tObjReusePool::recycle(magazine_p->pop());
+    }
+  depot_push_empty(magazine_p);
+  }
@@ -0,0 +1,516 @@
+//=======================================================================================
+// Agog Labs C++ library.
+// Copyright (c) 2000 Agog Labs Inc.,
+// All rights reserved.
+//
+//  Object Reuse Pool class template that can give unused memory back
+// Notes:
+//=======================================================================================
+
+#pragma once
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include <AgogCore/AObjReusePool.hpp>
+#include <AgogCore/APArray.hpp>
+
+
+//=======================================================================================
+// Global Structures
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+// Notes    Variant of AObjReusePool that can give completely unused expansion blocks back
+//          to the system after a usage spike - see trim() and set_trim_keep_free().
+//
+//          It keeps track of how many objects of each expansion block are in use, so
+//          allocate() and recycle() are a bit slower than those of AObjReusePool. The
+//          layout of AObjReusePool itself is left untouched, since its instantiations are
+//          shared with precompiled libraries - so only pools declared as
+//          AObjReusePoolTrimmable can be trimmed.
+//
+//          Just like for AObjReusePool, _ObjectType must provide get_pool_unused_next().
+// Arg      _ObjectType - the class/type of objects stored in the pool.
+// Examples:
+//   AObjReusePoolTrimmable<EventInfo> pool(256, 64);
+//   EventInfo * event_p = pool.allocate();
+//   pool.recycle(event_p);
+//   pool.trim(1024);  // E.g. once per frame
+template<class _ObjectType>
+class AObjReusePoolTrimmable : protected AObjReusePool<_ObjectType>
+  {
+  public:
+
+  // Common types
+
+    // Local shorthand for templates
+    typedef AObjReusePool<_ObjectType>           tObjReusePool;
+    typedef AObjReusePoolTrimmable<_ObjectType>  tObjReusePoolTrimmable;
+
+  // Common Methods
+
+    AObjReusePoolTrimmable(uint32_t initial_size, uint32_t expand_size);
+    ~AObjReusePoolTrimmable();
+
+  // Accessor Methods
+
+    using tObjReusePool::get_initial_size;
+    using tObjReusePool::get_expand_size;
+    using tObjReusePool::get_count_initial;
+    using tObjReusePool::get_count_used;
+    using tObjReusePool::get_count_max;
+    using tObjReusePool::get_count_overflow;
+    using tObjReusePool::get_count_available;
+    using tObjReusePool::get_bytes_allocated;
+
+    uint32_t get_count_expanded_blocks() const { return m_expanded_blocks.get_length(); }
+    uint32_t get_count_trimmed() const         { return m_count_trimmed; }
+    uint32_t get_trim_keep_free() const        { return m_trim_keep_free; }
+    bool     is_trimming() const               { return m_trim_draining_count != 0u; }
+
+  // Modifying Methods
+
+    _ObjectType * allocate();
+    void          recycle(_ObjectType * obj_p);
+
+    void          empty();
+    void          remove_expanded();
+
+    void          set_trim_keep_free(uint32_t keep_free_count) { m_trim_keep_free = keep_free_count; }
+    uint32_t      trim(uint32_t max_steps);
+
+  protected:
+
+  // Types
+
+    typedef typename tObjReusePool::AllocObject AllocObject;
+    typedef typename tObjReusePool::ObjBlock    ObjBlock;
+
+    // Usage of a block other than the initial one
+    struct BlockUsage
+      {
+      ObjBlock *    m_block_p;
+      uintptr_t     m_array_begin;    // Address range of the objects of the block
+      uintptr_t     m_array_end;
+      uint32_t      m_count_used;     // Number of objects of the block currently allocated
+      uint32_t      m_count_drained;  // Objects of the block already unlinked from the free list by trim()
+      AllocObject * m_drained_p;
+      bool          m_is_draining;    // Set if trim() is about to release this block
+      };
+
+  // Methods
+
+    void         add_block();
+    void         forget_expanded();
+    uint32_t     find_expanded_pos(uintptr_t obj_addr) const;
+    BlockUsage * find_expanded_block(const AllocObject * obj_p) const;
+    void         on_expanded_allocate(AllocObject * obj_p);
+    void         on_expanded_recycle(AllocObject * obj_p);
+    bool         trim_begin();
+    void         trim_cancel(BlockUsage * usage_p);
+    void         trim_release(BlockUsage * usage_p);
+
+  // Data Members
+
+    // Usage of all blocks except the initial one sorted by address - to quickly find the
+    // block an object belongs to
+    APArray<BlockUsage> m_expanded_blocks;
+
+    // trim() only releases blocks as long as at least this many free objects remain in
+    // expansion blocks - so usage oscillating around a block boundary does not cause
+    // blocks to be released and added back over and over
+    uint32_t m_trim_keep_free;
+
+    // Number of blocks currently being drained by trim()
+    uint32_t m_trim_draining_count;
+
+    // Number of objects whose memory trim() has given back so far
+    uint32_t m_count_trimmed;
+
+    // Last free object trim() has kept in the free list - it continues after this one
+    // on the next call. nullptr = start of free list.
+    AllocObject * m_trim_prev_p;
+
+  };  // AObjReusePoolTrimmable
+
+
+
+//=======================================================================================
+// Methods
+//=======================================================================================
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Common Methods
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+//---------------------------------------------------------------------------------------
+// Constructor
+// Returns:    itself
+// Arg         initial_size - initial object population for the reuse pool - never trimmed
+// Arg         expand_size - additional number of objects to allocate if all the objects
+//             in the reuse pool are in use and more objects are required.
+template<class _ObjectType>
+inline AObjReusePoolTrimmable<_ObjectType>::AObjReusePoolTrimmable(
+  uint32_t initial_size,
+  uint32_t expand_size
+  ) :
+  tObjReusePool(initial_size, expand_size),
+  m_trim_keep_free(2u * expand_size),
+  m_trim_draining_count(0u),
+  m_count_trimmed(0u),
+  m_trim_prev_p(nullptr)
+  {
+  }
+
+//---------------------------------------------------------------------------------------
+// Destructor
+// Notes:      Like AObjReusePool, object memory is only released via empty()
+template<class _ObjectType>
+inline AObjReusePoolTrimmable<_ObjectType>::~AObjReusePoolTrimmable()
+  {
+  m_expanded_blocks.free_all();
+  }
+
+//---------------------------------------------------------------------------------------
+// Retrieves a previously allocated object from the pool - see AObjReusePool::allocate()
+// Returns:    a dynamic object
+// See:        recycle()
+template<class _ObjectType>
+inline _ObjectType * AObjReusePoolTrimmable<_ObjectType>::allocate()
+  {
+  #ifdef AORPOOL_USAGE_COUNT
+    if (++this->m_count_now > this->m_count_max)
+      {
+      this->m_count_max = this->m_count_now;
+      }
+  #endif
+
+  if (!this->m_pool_first_p)
+    {
+    // No free objects, so make more
+    add_block();
+    }
+
+  // Unlink one object from the linked list of free objects
+  AllocObject * obj_p = this->m_pool_first_p;
+  this->m_pool_first_p = static_cast<AllocObject *>(*obj_p->get_pool_unused_next());
+
+  #ifdef AORPOOL_ALLOCATION_TRACKING
+    obj_p->m_call_stack.set();
+    this->m_allocated_list.append(obj_p);
+  #endif
+
+  // Keep track of usage of expansion blocks
+  if (!m_expanded_blocks.is_empty())
+    {
+    on_expanded_allocate(obj_p);
+    }
+
+  return obj_p;
+  }
+
+//---------------------------------------------------------------------------------------
+// Puts an object back into the pool - see AObjReusePool::recycle()
+// Arg         obj_p - pointer to object to free up and put into the pool.
+// See:        allocate()
+template<class _ObjectType>
+inline void AObjReusePoolTrimmable<_ObjectType>::recycle(_ObjectType * obj_p)
+  {
+  #ifdef AORPOOL_USAGE_COUNT
+    --this->m_count_now;
+  #endif
+
+  #ifdef AORPOOL_ALLOCATION_TRACKING
+    this->m_allocated_list.remove(static_cast<AllocObject *>(obj_p));
+  #endif
+
+  // Keep track of usage of expansion blocks
+  if (!m_expanded_blocks.is_empty())
+    {
+    on_expanded_recycle(static_cast<AllocObject *>(obj_p));
+    }
+
+  *obj_p->get_pool_unused_next() = this->m_pool_first_p;
+  this->m_pool_first_p = static_cast<AllocObject *>(obj_p);
+  }
+
+//---------------------------------------------------------------------------------------
+// Clears out pool - see AObjReusePool::empty()
+template<class _ObjectType>
+void AObjReusePoolTrimmable<_ObjectType>::empty()
+  {
+  forget_expanded();
+  tObjReusePool::empty();
+  }
+
+//---------------------------------------------------------------------------------------
+// Frees all expansion blocks - see AObjReusePool::remove_expanded()
+template<class _ObjectType>
+void AObjReusePoolTrimmable<_ObjectType>::remove_expanded()
+  {
+  forget_expanded();
+  tObjReusePool::remove_expanded();
+  }
+
+//---------------------------------------------------------------------------------------
+// Incrementally releases completely unused expansion blocks back to the system.
+// Meant to be called regularly, e.g. once per frame, with a small number of steps.
+//
+// Releasing a block requires unlinking all of its objects from the free list which
+// takes a walk through the free list. That walk is spread over as many calls as needed.
+// If an object of a block about to be released is allocated in the meantime, that block
+// is simply kept.
+//
+// Returns:    number of blocks released during this call
+// Arg         max_steps - maximum number of free objects to visit during this call
+// See:        set_trim_keep_free()
+template<class _ObjectType>
+uint32_t AObjReusePoolTrimmable<_ObjectType>::trim(uint32_t max_steps)
+  {
+  // Start a new pass if not in the middle of one
+  if (!m_trim_draining_count && !trim_begin())
+    {
+    return 0u;
+    }
+
+  uint32_t released_count = 0u;
+  for (uint32_t step = 0u; step < max_steps && m_trim_draining_count; ++step)
+    {
+    AllocObject * obj_p = m_trim_prev_p ? static_cast<AllocObject *>(*m_trim_prev_p->get_pool_unused_next()) : this->m_pool_first_p;
+    if (!obj_p)
+      {
+      break;
+      }
+
+    BlockUsage * usage_p = find_expanded_block(obj_p);
+    if (usage_p && usage_p->m_is_draining)
+      {
+      // Unlink from free list and remember with its block
+      AllocObject * next_p = static_cast<AllocObject *>(*obj_p->get_pool_unused_next());
+      if (m_trim_prev_p)
+        {
+        *m_trim_prev_p->get_pool_unused_next() = next_p;
+        }
+      else
+        {
+        this->m_pool_first_p = next_p;
+        }
+      *obj_p->get_pool_unused_next() = usage_p->m_drained_p;
+      usage_p->m_drained_p = obj_p;
+
+      // Got all of them?
+      if (++usage_p->m_count_drained == usage_p->m_block_p->m_size)
+        {
+        trim_release(usage_p);
+        released_count++;
+        }
+      }
+    else
+      {
+      // Keep and move on
+      m_trim_prev_p = obj_p;
+      }
+    }
+
+  // Done with this pass?
+  if (!m_trim_draining_count)
+    {
+    m_trim_prev_p = nullptr;
+    }
+
+  return released_count;
+  }
+
+//---------------------------------------------------------------------------------------
+// Creates a block of objects and starts tracking its usage if it is an expansion block
+template<class _ObjectType>
+void AObjReusePoolTrimmable<_ObjectType>::add_block()
+  {
+  bool is_expansion = !this->m_blocks.is_empty();
+
+  tObjReusePool::add_block();
+
+  if (is_expansion)
+    {
+    ObjBlock *   block_p = this->m_blocks.get_last();
+    BlockUsage * usage_p = new BlockUsage;
+
+    usage_p->m_block_p       = block_p;
+    usage_p->m_array_begin   = (uintptr_t)block_p->get_array();
+    usage_p->m_array_end     = usage_p->m_array_begin + block_p->m_size * sizeof(AllocObject);
+    usage_p->m_count_used    = 0u;
+    usage_p->m_count_drained = 0u;
+    usage_p->m_drained_p     = nullptr;
+    usage_p->m_is_draining   = false;
+
+    m_expanded_blocks.insert(*usage_p, find_expanded_pos(usage_p->m_array_begin));
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Stops tracking all expansion blocks and any trim in progress
+template<class _ObjectType>
+void AObjReusePoolTrimmable<_ObjectType>::forget_expanded()
+  {
+  m_expanded_blocks.free_all();
+  m_trim_draining_count = 0u;
+  m_trim_prev_p = nullptr;
+  }
+
+//---------------------------------------------------------------------------------------
+// Binary search for the position of the first expansion block starting after obj_addr
+template<class _ObjectType>
+uint32_t AObjReusePoolTrimmable<_ObjectType>::find_expanded_pos(uintptr_t obj_addr) const
+  {
+  BlockUsage ** usages_a = m_expanded_blocks.get_array();
+  uint32_t      low      = 0u;
+  uint32_t      high     = m_expanded_blocks.get_length();
+
+  while (low < high)
+    {
+    uint32_t mid = (low + high) >> 1;
+    if (usages_a[mid]->m_array_begin <= obj_addr)
+      {
+      low = mid + 1u;
+      }
+    else
+      {
+      high = mid;
+      }
+    }
+
+  return low;
+  }
+
+//---------------------------------------------------------------------------------------
+// Determines the block of an expansion object - or nullptr if it is in the initial block
+template<class _ObjectType>
+inline typename AObjReusePoolTrimmable<_ObjectType>::BlockUsage * AObjReusePoolTrimmable<_ObjectType>::find_expanded_block(const AllocObject * obj_p) const
+  {
+  uintptr_t obj_addr = (uintptr_t)obj_p;
+  uint32_t  pos      = find_expanded_pos(obj_addr);
+
+  // Block containing the address is the one right before the insert position
+  if (pos)
+    {
+    BlockUsage * usage_p = m_expanded_blocks.get_array()[pos - 1u];
+    if (obj_addr < usage_p->m_array_end)
+      {
+      return usage_p;
+      }
+    }
+
+  return nullptr;
+  }
+
+//---------------------------------------------------------------------------------------
+// Keeps usage count of expansion blocks up to date
+template<class _ObjectType>
+void AObjReusePoolTrimmable<_ObjectType>::on_expanded_allocate(AllocObject * obj_p)
+  {
+  // If trim() was going to continue after this object, it must start over
+  if (obj_p == m_trim_prev_p)
+    {
+    m_trim_prev_p = nullptr;
+    }
+
+  BlockUsage * usage_p = find_expanded_block(obj_p);
+  if (usage_p)
+    {
+    usage_p->m_count_used++;
+
+    // Block is needed again after all
+    if (usage_p->m_is_draining)
+      {
+      trim_cancel(usage_p);
+      }
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Keeps usage count of expansion blocks up to date
+template<class _ObjectType>
+inline void AObjReusePoolTrimmable<_ObjectType>::on_expanded_recycle(AllocObject * obj_p)
+  {
+  BlockUsage * usage_p = find_expanded_block(obj_p);
+  if (usage_p)
+    {
+    usage_p->m_count_used--;
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Starts a new trim pass by marking the expansion blocks to release
+// Returns:    true if there is anything to release
+template<class _ObjectType>
+bool AObjReusePoolTrimmable<_ObjectType>::trim_begin()
+  {
+  // Count free objects in expansion blocks
+  uint32_t      free_count = 0u;
+  uint32_t      count      = m_expanded_blocks.get_length();
+  BlockUsage ** usages_a   = m_expanded_blocks.get_array();
+  for (uint32_t i = 0u; i < count; ++i)
+    {
+    free_count += usages_a[i]->m_block_p->m_size - usages_a[i]->m_count_used;
+    }
+
+  // Mark unused blocks - starting at the highest addresses - as long as enough free objects remain
+  for (uint32_t i = count; i-- > 0u && free_count > m_trim_keep_free;)
+    {
+    BlockUsage * usage_p = usages_a[i];
+    uint32_t     size    = usage_p->m_block_p->m_size;
+    if (!usage_p->m_count_used && free_count - size >= m_trim_keep_free)
+      {
+      usage_p->m_is_draining = true;
+      free_count -= size;
+      m_trim_draining_count++;
+      }
+    }
+
+  m_trim_prev_p = nullptr;
+  return m_trim_draining_count != 0u;
+  }
+
+//---------------------------------------------------------------------------------------
+// Keeps a block that was about to be released and puts its objects back into the free list
+template<class _ObjectType>
+void AObjReusePoolTrimmable<_ObjectType>::trim_cancel(BlockUsage * usage_p)
+  {
+  if (usage_p->m_drained_p)
+    {
+    AllocObject * last_p = usage_p->m_drained_p;
+    for (uint32_t i = 1u; i < usage_p->m_count_drained; ++i)
+      {
+      last_p = static_cast<AllocObject *>(*last_p->get_pool_unused_next());
+      }
+    *last_p->get_pool_unused_next() = this->m_pool_first_p;
+    this->m_pool_first_p = usage_p->m_drained_p;
+    }
+
+  usage_p->m_drained_p = nullptr;
+  usage_p->m_count_drained = 0u;
+  usage_p->m_is_draining = false;
+  m_trim_draining_count--;
+  }
+
+//---------------------------------------------------------------------------------------
+// Frees a block once all of its objects were unlinked from the free list
+template<class _ObjectType>
+void AObjReusePoolTrimmable<_ObjectType>::trim_release(BlockUsage * usage_p)
+  {
+  ObjBlock * block_p = usage_p->m_block_p;
+
+  m_expanded_blocks.remove(find_expanded_pos(usage_p->m_array_begin) - 1u);
+  this->m_blocks.remove(block_p);
+  m_trim_draining_count--;
+  m_count_trimmed += block_p->m_size;
+
+  #ifdef AORPOOL_USAGE_COUNT
+    this->m_count_total -= block_p->m_size;
+  #endif
+
+  delete usage_p;
+  AgogCore::get_app_info()->free(block_p);
+  }
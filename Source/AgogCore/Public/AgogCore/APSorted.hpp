@@ -127,6 +127,7 @@ class APSorted : public APSizedArrayBase<_ElementType>
     void           append_all(const APSorted & sorted);
     void           append_all(const _ElementType ** elems_p, uint32_t elem_count, bool pre_sorted = false);
     void           append_all(const _ElementType * elems_p, uint32_t elem_count, bool pre_sorted = false);
+    void           append_unsorted(const _ElementType & elem);
     _ElementType * append_replace(const _ElementType & elem, uint32_t * insert_pos_p = nullptr);
     void           append_replace_free_all(const APSorted & sorted);
     bool           free(const _KeyType & key, uint32_t instance = AMatch_first_found, uint32_t * find_pos_p = nullptr, uint32_t start_pos = 0, uint32_t end_pos = ALength_remainder);
@@ -143,6 +144,7 @@ class APSorted : public APSizedArrayBase<_ElementType>
     uint32_t       remove_all(const _KeyType & key, uint32_t start_pos = 0u, uint32_t end_pos = ALength_remainder);
     uint32_t       remove_all(const APSorted & sorted, uint32_t start_pos = 0u, uint32_t end_pos = ALength_remainder);
     uint32_t       remove_all_all(const APSorted & sorted, uint32_t start_pos = 0u, uint32_t end_pos = ALength_remainder);
+    void           merge(uint32_t run_pos);
     void           sort(uint32_t start_pos = 0u, uint32_t end_pos = ALength_remainder);
     void           xfer_absent_all_free_dupes(APSorted * sorted_p);
 
@@ -549,9 +551,9 @@ bool APSorted<_ElementType, _KeyType, _CompareClass>::append_absent(
 //   sorted1.append_absent_all(sorted2);
 //
 // #Notes
-//   This is essentially a 'set union'.
-//   [Efficiency] Instead of just sort() - sort only the new elements then do merge sort
-//   of previous elements and new elements.
+//   This is essentially a 'set union'.  Both arrays are walked once in step and merged
+//   into a new buffer - O(n + m) rather than a find() and insert per element.  If
+//   sorted has several equal elements only the first is appended.
 //
 // #See Also
 //   get_all() - 'set intersection', remove_all() - 'set subtraction',
@@ -568,46 +570,56 @@ void APSorted<_ElementType, _KeyType, _CompareClass>::append_absent_all(
 
   if (sorted_length)
     {
-    uint32_t length = this->m_count;
-    uint32_t size   = this->m_size;
-
-    // An ensure_size() before all the appends could needlessly expand the size of the
-    // array if the elements are already present.
-
-    uint32_t        pos;
-    _ElementType ** array_pp     = this->m_array_p;  // for faster than data member access
+    uint32_t        length       = this->m_count;
+    uint32_t        merged_size  = AMemory::request_pointer_count(length + sorted_length);
+    _ElementType ** merged_pp    = tAPArrayBase::alloc_array(merged_size);
+    _ElementType ** dest_pp      = merged_pp;
+    _ElementType ** array_pp     = this->m_array_p;
+    _ElementType ** array_end_pp = array_pp + length;
     _ElementType ** elems_pp     = sorted.m_array_p;
     _ElementType ** elems_end_pp = elems_pp + sorted_length;
-    _ElementType ** old_array_pp;
+    ptrdiff_t       result;
 
     for (; elems_pp < elems_end_pp; elems_pp++)
       {
-      if (!find(**elems_pp, AMatch_first_found, &pos))
+      // Keep existing elements that sort before
+      result = 1;
+      while ((array_pp < array_end_pp) && ((result = _CompareClass::comparison(**array_pp, **elems_pp)) < 0))
         {
-        // Resize needed?
-        if (size < length + 1u)  // Needs more space
-          {
-          old_array_pp = this->m_array_p;
+        *dest_pp++ = *array_pp++;
+        }
 
-          size            = AMemory::request_pointer_count_expand(length + 1u);
-          this->m_size    = size;
-          array_pp        = tAPArrayBase::alloc_array(this->m_size);
-          this->m_array_p = array_pp;
-          ::memcpy(array_pp, old_array_pp, pos * sizeof(_ElementType *));
-          ::memcpy(array_pp + pos + 1u, old_array_pp + pos, (length - pos) * sizeof(_ElementType *));
-          tAPArrayBase::free_array(old_array_pp);
-          }
-        else  // enough size in existing array
-          {
-          ::memmove(array_pp + pos + 1u, array_pp + pos, (length - pos) * sizeof(_ElementType *));
-          }
+      // Append if not present and not a repeat of the previous element in sorted
+      if ((result != 0)
+        && ((elems_pp == sorted.m_array_p) || (_CompareClass::comparison(*elems_pp[-1], **elems_pp) != 0)))
+        {
+        *dest_pp++ = *elems_pp;
+        }
+      }
 
-        array_pp[pos] = const_cast<_ElementType *>(*elems_pp);  // insert element
-        length++;
+    ::memcpy(dest_pp, array_pp, (array_end_pp - array_pp) * sizeof(_ElementType *));
 
-        this->m_count = length;
+    uint32_t merged_length = uint32_t(dest_pp - merged_pp) + uint32_t(array_end_pp - array_pp);
+
+    // Use the merged buffer only if the current one is too small - an ensure_size() up
+    // front could needlessly expand the array if the elements are already present.
+    if (merged_length > this->m_size)
+      {
+      tAPArrayBase::free_array(this->m_array_p);
+      this->m_array_p = merged_pp;
+      this->m_size    = merged_size;
+      }
+    else
+      {
+      if (merged_length != length)
+        {
+        ::memcpy(this->m_array_p, merged_pp, merged_length * sizeof(_ElementType *));
         }
+
+      tAPArrayBase::free_array(merged_pp);
       }
+
+    this->m_count = merged_length;
     }
   }
 
@@ -627,19 +639,7 @@ void APSorted<_ElementType, _KeyType, _CompareClass>::append_all(
   bool                              pre_sorted // = false
   )
   {
-  uint32_t length = array.get_length();
-
-  this->ensure_size(this->m_count + length);
-  ::memcpy(this->m_array_p + this->m_count, array.get_array(), length * sizeof(_ElementType *));
-  this->m_count += length;
-
-  // Check for special case where no merge is necessary
-  if ((!pre_sorted) || (this->m_count != length))
-    {
-    // $Revisit - CReis [Efficiency] Instead of just sort() - sort only the new elements if
-    // presorted, then do merge sort of previous elements and new elements.
-    sort();
-    }
+  append_all(const_cast<const _ElementType **>(array.get_array()), array.get_length(), pre_sorted);
   }
 
 //---------------------------------------------------------------------------------------
@@ -650,19 +650,7 @@ void APSorted<_ElementType, _KeyType, _CompareClass>::append_all(
 template<class _ElementType, class _KeyType, class _CompareClass>
 void APSorted<_ElementType, _KeyType, _CompareClass>::append_all(const tAPSorted & sorted)
   {
-  uint32_t length = sorted.get_length();
-
-  this->ensure_size(this->m_count + length);
-  ::memcpy(this->m_array_p + this->m_count, sorted.get_array(), length * sizeof(_ElementType *));
-  this->m_count += length;
-
-  // Check for special case where no merge is necessary
-  if (this->m_count != length)
-    {
-    // $Revisit - CReis [Efficiency] Instead of just sort() - sort only the new elements
-    // then do merge sort of previous elements and new elements.
-    sort();
-    }
+  append_all(const_cast<const _ElementType **>(sorted.get_array()), sorted.get_length(), true);
   }
 
 //---------------------------------------------------------------------------------------
@@ -685,16 +673,21 @@ void APSorted<_ElementType, _KeyType, _CompareClass>::append_all(
   bool                  pre_sorted // = false
   )
   {
-  this->ensure_size(this->m_count + elem_count);
-  ::memcpy(this->m_array_p + this->m_count, elems_p, elem_count * sizeof(_ElementType *));
-  this->m_count += elem_count;
-
-  // Check for special case where no merge is necessary
-  if ((!pre_sorted) || (this->m_count != elem_count))
+  if (elem_count)
     {
-    // $Revisit - CReis [Efficiency] Instead of just sort() - sort only the new elements if
-    // presorted, then do merge sort of previous elements and new elements.
-    sort();
+    uint32_t run_pos = this->m_count;
+
+    this->ensure_size(run_pos + elem_count);
+    ::memcpy(this->m_array_p + run_pos, elems_p, elem_count * sizeof(_ElementType *));
+    this->m_count += elem_count;
+
+    // Sort only the new elements then merge them with the previous elements
+    if (!pre_sorted)
+      {
+      sort(run_pos);
+      }
+
+    merge(run_pos);
     }
   }
 
@@ -720,25 +713,47 @@ void APSorted<_ElementType, _KeyType, _CompareClass>::append_all(
   {
   if (elem_count)
     {
-    this->ensure_size(this->m_count + elem_count);
+    uint32_t run_pos = this->m_count;
+
+    this->ensure_size(run_pos + elem_count);
 
-    uint32_t           find_pos;
     const _ElementType * elem_p      = elems_p;
     const _ElementType * elems_end_p = elems_p + elem_count;
-    _ElementType **      array_p     = this->m_array_p;  // For quick access
+    _ElementType **      array_p     = this->m_array_p + run_pos;
+
+    for(; elem_p < elems_end_p; elem_p++, array_p++)
+      {
+      *array_p = const_cast<_ElementType *>(elem_p);
+      }
 
-    // $Revisit - CReis [Efficiency] Appropriately use 'pre_sorted'
+    this->m_count += elem_count;
 
-    for(; elem_p < elems_end_p; elem_p++)
+    // Sort only the new elements then merge them with the previous elements
+    if (!pre_sorted)
       {
-      find(*elem_p, AMatch_first_found, &find_pos);
-      ::memmove(array_p + find_pos + 1u, array_p + find_pos, (this->m_count - find_pos) * sizeof(_ElementType *));
-      array_p[find_pos] = const_cast<_ElementType *>(elem_p);  // insert element
-      this->m_count++;
+      sort(run_pos);
       }
+
+    merge(run_pos);
     }
   }
 
+//---------------------------------------------------------------------------------------
+// Appends an element to the end without keeping the array sorted - for building a large
+// sorted array in bulk.  Call sort() once after all the elements are appended - or
+// merge() if they were appended in sorted order - and before the array is searched.
+//
+// #Examples
+//   for (...) { sorted.append_unsorted(*elem_p); }
+//   sorted.sort();
+//
+// #See Also  append_all(), merge(), sort()
+template<class _ElementType, class _KeyType, class _CompareClass>
+inline void APSorted<_ElementType, _KeyType, _CompareClass>::append_unsorted(const _ElementType & elem)
+  {
+  this->insert(elem, this->m_count);
+  }
+
 //---------------------------------------------------------------------------------------
 //  Appends an element to the APSorted array if it is not already present or
 //              replaces first found matching element.
@@ -2320,6 +2335,60 @@ bool APSorted<_ElementType, _KeyType, _CompareClass>::find_instance(
   return true;
   }
 
+//---------------------------------------------------------------------------------------
+// Merges the two sorted runs [0, run_pos) and [run_pos, length) into one sorted array in
+// a single pass - O(n) rather than the O(n log n) of a sort() or the O(n^2) of
+// inserting the elements of the second run one at a time.  Elements of the second run
+// end up after equal elements of the first run.
+//
+// #Examples
+//   uint32_t run_pos = sorted.get_length();
+//   for (...) { sorted.append_unsorted(*elem_p); }  // In sorted order
+//   sorted.merge(run_pos);
+//
+// #See Also  append_unsorted(), append_all(), sort()
+template<class _ElementType, class _KeyType, class _CompareClass>
+void APSorted<_ElementType, _KeyType, _CompareClass>::merge(uint32_t run_pos)
+  {
+  uint32_t length     = this->m_count;
+  uint32_t run_length = length - run_pos;
+
+  A_ASSERTX(run_pos <= length, "APSorted::merge() - run position out of range!");
+
+  // Nothing to merge or already in order?
+  if ((run_pos == 0u)
+    || (run_length == 0u)
+    || (_CompareClass::comparison(*this->m_array_p[run_pos - 1u], *this->m_array_p[run_pos]) <= 0))
+    {
+    return;
+    }
+
+  // Move the second run out of the way then merge from the back so every element is
+  // moved only once
+  _ElementType ** run_pp = tAPArrayBase::alloc_array(run_length);
+
+  ::memcpy(run_pp, this->m_array_p + run_pos, run_length * sizeof(_ElementType *));
+
+  _ElementType ** array_pp     = this->m_array_p;
+  _ElementType ** first_end_pp = array_pp + run_pos;
+  _ElementType ** run_end_pp   = run_pp + run_length;
+  _ElementType ** dest_pp      = array_pp + length;
+
+  while (run_end_pp > run_pp)
+    {
+    if ((first_end_pp > array_pp) && (_CompareClass::comparison(*run_end_pp[-1], *first_end_pp[-1]) < 0))
+      {
+      *(--dest_pp) = *(--first_end_pp);
+      }
+    else
+      {
+      *(--dest_pp) = *(--run_end_pp);
+      }
+    }
+
+  tAPArrayBase::free_array(run_pp);
+  }
+
 //---------------------------------------------------------------------------------------
 //  Sorts the elements in the APSorted from start_pos to end_pos.
 // Arg          start_pos - first position to start sorting  (Default 0)
@@ -949,6 +949,26 @@ namespace AgogCore
   A_API AAppInfoCore *  get_app_info();
   A_API void            set_app_info(AAppInfoCore * app_info_p);
 
+  // Returned by get_thread_slot() while a thread is exiting after it gave its slot back -
+  // per-thread data must not be used anymore and callers fall back to shared data
+  const uint32_t ThreadSlot_none = ADef_uint32;
+
+  // Small unique index of the calling thread - assigned on first call, starting at 0
+  // and handed out again once the thread exits
+  A_API uint32_t        get_thread_slot();
+
+  // Called on a thread that obtained a slot via get_thread_slot() right before the
+  // thread exits and its slot is handed out again - e.g. to flush per-thread caches
+  struct AThreadExitFunc
+    {
+    void (* m_func_p)(void * user_p, uint32_t thread_slot);
+    void *            m_user_p;
+    AThreadExitFunc * m_next_p;
+    };
+
+  A_API void            register_thread_exit_func(AThreadExitFunc * exit_func_p);
+  A_API void            unregister_thread_exit_func(AThreadExitFunc * exit_func_p);
+
   }
 
 //---------------------------------------------------------------------------------------
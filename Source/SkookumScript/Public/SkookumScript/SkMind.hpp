@@ -91,6 +91,7 @@ class SK_API SkMind : public SkClassBindingAbstract<SkMind>, public SkDataInstan
     bool is_updating() const                            { return (m_mind_flags & Flag_updating) != 0u; }
     bool is_on_update_list() const                      { return (m_mind_flags & Flag_on_update_list) != 0u; }
     
+    uint32_t get_mind_flags() const                     { return m_mind_flags; }
     void clear_mind_flags(uint32_t flags)               { m_mind_flags &= ~flags; }
     void set_mind_flags(uint32_t flags)                 { m_mind_flags |= flags; }
     bool is_mind_flags(uint32_t flags) const            { return (m_mind_flags & flags) == flags; }
@@ -11,6 +11,7 @@
 #include "CoreUObject.h"
 #include "Regex.h"
 #include "Runtime/Core/Public/Features/IModularFeatures.h"
+#include "Async/ParallelFor.h"
 
 #include "SkookumScriptGeneratorBase.inl"
 
@@ -45,9 +46,10 @@ class FSkookumScriptGenerator : public ISkookumScriptGenerator, public FSkookumS
   // Processing phase of this plugin
   enum ePhase
     {
-    Phase_gathering,  // Gathering information from UHT
-    Phase_generating, // Generating type information
-    Phase_saving,     // Saving out to disk
+    Phase_gathering,    // Gathering information from UHT
+    Phase_discovering,  // Discovering all types that need to be generated (serial)
+    Phase_generating,   // Generating type information (parallel - no new types may be requested)
+    Phase_saving,       // Saving out to disk
     };
 
   // Indicates where a class is being declared
@@ -190,6 +192,16 @@ class FSkookumScriptGenerator : public ISkookumScriptGenerator, public FSkookumS
     TArray<EventBinding>    m_event_bindings;
     };
 
+  // Everything determined about a type during discovery that its generation depends on
+  // Discovery is serial since it adds to m_types_to_generate, generation then runs in parallel
+  struct TypeGenerationWork
+    {
+    int32             m_generated_type_index; // Slot in m_types_generated reserved for this type
+    int32             m_include_priority;
+    uint32            m_referenced_flags;
+    RoutineBindings   m_bindings;             // Method and event bindings (classes only)
+    };
+
   //---------------------------------------------------------------------------------------
   // Data
 
@@ -223,11 +235,12 @@ class FSkookumScriptGenerator : public ISkookumScriptGenerator, public FSkookumS
 
   void                  generate_all_bindings(eClassScope class_scope);
 
-  int32                 generate_class(UStruct * struct_or_class_p, int32 include_priority, uint32 referenced_flags, eClassScope class_scope); // Generate script and binding files for a class and its methods and properties
+  void                  discover_type(UField * type_p, eClassScope class_scope, TypeGenerationWork * work_p); // Determine type info and bindings, and request generation of all types referenced by this type
+  void                  generate_class(UStruct * struct_or_class_p, const TypeGenerationWork & work); // Generate script and binding files for a class and its methods and properties
   FString               generate_class_header_file_body(UStruct * struct_or_class_p, const RoutineBindings & bindings, eClassScope class_scope); // Generate header file body for a class
   FString               generate_class_binding_file_body(UStruct * struct_or_class_p, const RoutineBindings & bindings); // Generate binding code source file for a class or struct
 
-  int32                 generate_enum(UEnum * enum_p, int32 include_priority, uint32 referenced_flags, eClassScope class_scope); // Generate files for an enum
+  void                  generate_enum(UEnum * enum_p, const TypeGenerationWork & work); // Generate files for an enum
   FString               generate_enum_header_file_body(UEnum * enum_p, eClassScope class_scope); // Generate header file body for an enum
   FString               generate_enum_binding_file_body(UEnum * enum_p); // Generate binding code source file for an enum
 
@@ -249,6 +262,9 @@ class FSkookumScriptGenerator : public ISkookumScriptGenerator, public FSkookumS
 
   FString               generate_return_value_passing(UProperty * return_value_p, const FString & return_value_name); // Generate code that passes back the return value
   FString               generate_var_to_instance_expression(UProperty * var_p, const FString & var_name); // Generate code that creates an SkInstance from a property
+  FString               generate_event_filter_code(const EventBinding & binding); // Generate code that drops events not passing the listener's event filter
+  FString               generate_event_key_code(const EventBinding & binding); // Generate code that gets a payload argument as key for the dedupe queue policy
+  static UClass *       get_event_payload_weak_class(UProperty * param_p); // Class of objects an event payload member references weakly or nullptr
 
   void                  save_generated_cpp_files(eClassScope class_scope);
   bool                  save_generated_script_files(eClassScope class_scope);
@@ -387,8 +403,8 @@ FString FSkookumScriptGenerator::GetGeneratorName() const
 
 void FSkookumScriptGenerator::generate_all_bindings(eClassScope class_scope)
   {
-  // Generating phase first
-  m_phase = Phase_generating;
+  // Discovering phase first
+  m_phase = Phase_discovering;
 
   // Get target info
   const GenerationTarget & target = m_targets[class_scope];
@@ -459,29 +475,44 @@ void FSkookumScriptGenerator::generate_all_bindings(eClassScope class_scope)
     }
 #endif
 
-  // 5) Loop until all types have been generated
-  // Note that the array will grow as we generate but the index will eventually catch up
+  // 5) Loop until all types have been discovered
+  // Note that the array will grow as we discover but the index will eventually catch up
   m_types_generated.Empty();
+  TArray<TypeGenerationWork> work_items;
+  work_items.Reserve(m_types_to_generate.Num());
   for (int32 i = 0; i < m_types_to_generate.Num(); ++i)
     {
-    // Get next element in list
-    const TypeToGenerate & type_to_generate = m_types_to_generate[i];
+    // Get next element in list - copy what we need as discovery may grow the array
+    UField * type_p = m_types_to_generate[i].m_type_p;
+
+    // Reserve a slot for it, slots are in discovery order so output is deterministic
+    TypeGenerationWork & work = work_items[work_items.Emplace()];
+    work.m_generated_type_index = m_types_generated.Emplace();
+    work.m_include_priority = m_types_to_generate[i].m_include_priority;
+    work.m_referenced_flags = m_types_to_generate[i].m_referenced_flags;
+    discover_type(type_p, class_scope, &work);
 
-    // Generate structure for it (if not there already)
-    UStruct * struct_or_class_p;
-    int32 generated_index;
-    if ((struct_or_class_p = Cast<UStruct>(type_to_generate.m_type_p)) != nullptr)
+    // Remember index for later
+    m_types_to_generate[i].m_generated_type_index = (int16)work.m_generated_type_index;
+    }
+
+  // 6) Generate code and scripts for all types
+  // Each type only writes to its own slot in m_types_generated so this can be done in parallel
+  m_phase = Phase_generating;
+  ParallelFor(work_items.Num(), [this, &work_items](int32 work_index)
+    {
+    const TypeGenerationWork & work = work_items[work_index];
+    UField * type_p = m_types_generated[work.m_generated_type_index].m_type_p;
+    UStruct * struct_or_class_p = Cast<UStruct>(type_p);
+    if (struct_or_class_p)
       {
-      generated_index = generate_class(struct_or_class_p, type_to_generate.m_include_priority, type_to_generate.m_referenced_flags, class_scope);
+      generate_class(struct_or_class_p, work);
       }
     else
       {
-      generated_index = generate_enum(CastChecked<UEnum>(type_to_generate.m_type_p), type_to_generate.m_include_priority, type_to_generate.m_referenced_flags, class_scope);
+      generate_enum(CastChecked<UEnum>(type_p), work);
       }
-
-    // Remember index for later
-    m_types_to_generate[i].m_generated_type_index = (int16)generated_index;
-    }
+    });
 
   // Now we are saving things out
   m_phase = Phase_saving;
@@ -495,26 +526,89 @@ void FSkookumScriptGenerator::generate_all_bindings(eClassScope class_scope)
 
 //---------------------------------------------------------------------------------------
 
-int32 FSkookumScriptGenerator::generate_class(UStruct * struct_or_class_p, int32 include_priority, uint32 referenced_flags, eClassScope class_scope)
+void FSkookumScriptGenerator::discover_type(UField * type_p, eClassScope class_scope, TypeGenerationWork * work_p)
   {
-  UE_LOG(LogSkookumScriptGenerator, Log, TEXT("Generating struct/class %s"), *get_skookum_class_name(struct_or_class_p));
+  GeneratedType & generated_type = m_types_generated[work_p->m_generated_type_index];
 
-  // Allocate structure
-  int32 generated_index = m_types_generated.Emplace();
-  GeneratedType & generated_class = m_types_generated[generated_index];
+  const ModuleInfo * module_p = m_targets[class_scope].get_module(type_p);
 
-  FString skookum_class_name = get_skookum_class_name(struct_or_class_p);
-  const ModuleInfo * module_p = m_targets[class_scope].get_module(struct_or_class_p);
+  // Remember info about type
+  generated_type.m_type_p = type_p;
+  generated_type.m_sk_name = get_skookum_class_name(type_p);
+  generated_type.m_class_scope = module_p ? module_p->m_scope : ClassScope_engine;
+  generated_type.m_is_hierarchy_stub = false; // || !module_p;
 
-  // Remember info about class
-  generated_class.m_type_p = struct_or_class_p;
-  generated_class.m_sk_name = skookum_class_name;
-  generated_class.m_class_scope = module_p ? module_p->m_scope : ClassScope_engine;
+  // Enums do not reference any other types
+  UStruct * struct_or_class_p = Cast<UStruct>(type_p);
+  if (!struct_or_class_p)
+    {
+    return;
+    }
+
+  UE_LOG(LogSkookumScriptGenerator, Log, TEXT("Generating struct/class %s"), *generated_type.m_sk_name);
 
   // Determine if it's just a stub (i.e. Sk built-in struct like Vector3, Transform, SkookumScriptBehaviorComponent etc.)
   eSkTypeID type_id = get_skookum_struct_type(struct_or_class_p);
   bool has_built_in_name = struct_or_class_p->GetName() == TEXT("SkookumScriptBehaviorComponent");
-  generated_class.m_is_hierarchy_stub = (type_id != SkTypeID_UStruct && type_id != SkTypeID_UClass) || has_built_in_name; // || !module_p;
+  generated_type.m_is_hierarchy_stub = (type_id != SkTypeID_UStruct && type_id != SkTypeID_UClass) || has_built_in_name; // || !module_p;
+  if (generated_type.m_is_hierarchy_stub)
+    {
+    return;
+    }
+
+  // Request all types used by instance data members
+  for (TFieldIterator<UProperty> property_it(struct_or_class_p, EFieldIteratorFlags::ExcludeSuper); property_it; ++property_it)
+    {
+    can_export_property(*property_it, work_p->m_include_priority, work_p->m_referenced_flags);
+    }
+
+  // Build array of all methods and events (only for classes)
+  UClass * class_p = Cast<UClass>(struct_or_class_p);
+  if (class_p)
+    {
+    RoutineBindings & bindings = work_p->m_bindings;
+    uint32 referenced_flags = work_p->m_referenced_flags | (class_scope == generated_type.m_class_scope ? Referenced_as_binding_class : 0);
+
+    MethodBinding method;
+    for (TFieldIterator<UFunction> func_it(struct_or_class_p, EFieldIteratorFlags::ExcludeSuper); func_it; ++func_it)
+      {
+      UFunction * function_p = *func_it;
+      if (can_export_method(function_p, work_p->m_include_priority, referenced_flags))
+        {
+        method.make_method(function_p);
+        if (bindings.m_method_bindings[Scope_instance].Find(method) < 0 && bindings.m_method_bindings[Scope_class].Find(method) < 0) // If method with this name already bound, assume it does the same thing and skip
+          {
+          // Remember binding for later
+          bool is_static = function_p->HasAnyFunctionFlags(FUNC_Static);
+          bindings.m_method_bindings[is_static ? Scope_class : Scope_instance].Push(method);
+          }
+        }
+      }
+
+    EventBinding event;
+    for (TFieldIterator<UProperty> property_it(struct_or_class_p, EFieldIteratorFlags::ExcludeSuper); property_it; ++property_it)
+      {
+      UMulticastDelegateProperty * delegate_property_p = Cast<UMulticastDelegateProperty>(*property_it);
+      if (delegate_property_p 
+       && delegate_property_p->HasAnyPropertyFlags(CPF_NativeAccessSpecifierPublic)
+       && !delegate_property_p->HasAnyPropertyFlags(CPF_EditorOnly)
+       && can_export_method(delegate_property_p->SignatureFunction, work_p->m_include_priority, referenced_flags, true))
+        {
+        // Remember binding for later
+        event.make_event(delegate_property_p);
+        bindings.m_event_bindings.Push(event);
+        }
+      }
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+
+void FSkookumScriptGenerator::generate_class(UStruct * struct_or_class_p, const TypeGenerationWork & work)
+  {
+  // Note: This is called in parallel for many types so must only modify its own generated type
+  GeneratedType & generated_class = m_types_generated[work.m_generated_type_index];
+  const FString & skookum_class_name = generated_class.m_sk_name;
 
   // Generate meta file
   generated_class.m_sk_meta_file_body = generate_class_meta_file_body(struct_or_class_p);
@@ -523,10 +617,11 @@ int32 FSkookumScriptGenerator::generate_class(UStruct * struct_or_class_p, int32
   if (!generated_class.m_is_hierarchy_stub)
     {
     // Generate instance data members
-    generated_class.m_sk_instance_data_file_body = generate_class_instance_data_file_body(struct_or_class_p, include_priority, referenced_flags);
+    generated_class.m_sk_instance_data_file_body = generate_class_instance_data_file_body(struct_or_class_p, work.m_include_priority, work.m_referenced_flags);
 
     // For structs, generate ctor/ctor_copy/op_assign/dtor
-    if (!Cast<UClass>(struct_or_class_p))
+    UClass * class_p = Cast<UClass>(struct_or_class_p);
+    if (!class_p)
       {
       generated_class.m_sk_routines.Add({ TEXT("!"), false, FString::Printf(TEXT("() %s\r\n"), *skookum_class_name) });
       generated_class.m_sk_routines.Add({ TEXT("!copy"), false, FString::Printf(TEXT("(%s other) %s\r\n"), *skookum_class_name, *skookum_class_name) });
@@ -534,64 +629,33 @@ int32 FSkookumScriptGenerator::generate_class(UStruct * struct_or_class_p, int32
       generated_class.m_sk_routines.Add({ TEXT("!!"), false, TEXT("()\r\n") });
       }
 
-    // Build array of all methods (only for classes)
-    // And generate script code
-    RoutineBindings bindings;
-    UClass * class_p = Cast<UClass>(struct_or_class_p);
-    if (class_p)
+    // Generate script code for all methods and events discovered earlier
+    const RoutineBindings & bindings = work.m_bindings;
+    for (uint32 scope = 0; scope < 2; ++scope)
       {
-      MethodBinding method;
-      for (TFieldIterator<UFunction> func_it(struct_or_class_p, EFieldIteratorFlags::ExcludeSuper); func_it; ++func_it)
+      for (auto & method : bindings.m_method_bindings[scope])
         {
-        UFunction * function_p = *func_it;
-        if (can_export_method(function_p, include_priority, referenced_flags | (class_scope == generated_class.m_class_scope ? Referenced_as_binding_class : 0)))
-          {
-          method.make_method(function_p);
-          if (bindings.m_method_bindings[Scope_instance].Find(method) < 0 && bindings.m_method_bindings[Scope_class].Find(method) < 0) // If method with this name already bound, assume it does the same thing and skip
-            {
-            // Remember binding for later
-            bool is_static = function_p->HasAnyFunctionFlags(FUNC_Static);
-            bindings.m_method_bindings[is_static ? Scope_class : Scope_instance].Push(method);
-
-            // Generate script code
-            generated_class.m_sk_routines.Add({ method.m_script_name, is_static, generate_method_script_file_body(function_p, method.m_script_name) });
-            }
-          }
+        generated_class.m_sk_routines.Add({ method.m_script_name, scope == Scope_class, generate_method_script_file_body(method.m_function_p, method.m_script_name) });
         }
-
-      EventBinding event;
-      for (TFieldIterator<UProperty> property_it(struct_or_class_p, EFieldIteratorFlags::ExcludeSuper); property_it; ++property_it)
+      }
+    for (auto & event : bindings.m_event_bindings)
+      {
+      for (int i = 0; i < EventCoro__count; ++i)
         {
-        UMulticastDelegateProperty * delegate_property_p = Cast<UMulticastDelegateProperty>(*property_it);
-        if (delegate_property_p 
-         && delegate_property_p->HasAnyPropertyFlags(CPF_NativeAccessSpecifierPublic)
-         && !delegate_property_p->HasAnyPropertyFlags(CPF_EditorOnly)
-         && can_export_method(delegate_property_p->SignatureFunction, include_priority, referenced_flags | (class_scope == generated_class.m_class_scope ? Referenced_as_binding_class : 0), true))
-          {
-          // Remember binding for later
-          event.make_event(delegate_property_p);
-          bindings.m_event_bindings.Push(event);
-
-          // Generate script code
-          for (int i = 0; i < EventCoro__count; ++i)
-            {
-            FString coro_name;
-            FString coro_body = generate_event_script_file_body(eEventCoro(i), delegate_property_p, event.m_script_name_base, &coro_name);
-            generated_class.m_sk_routines.Add({ coro_name, false, coro_body });
-            }
-          }
+        FString coro_name;
+        FString coro_body = generate_event_script_file_body(eEventCoro(i), event.m_property_p, event.m_script_name_base, &coro_name);
+        generated_class.m_sk_routines.Add({ coro_name, false, coro_body });
         }
       }
 
     // Generate binding code files
+    eSkTypeID type_id = get_skookum_struct_type(struct_or_class_p);
     const TCHAR * class_or_struct_text_p          = (type_id == SkTypeID_UClass ? TEXT("class") : TEXT("struct"));
     generated_class.m_cpp_header_file_body        = generate_class_header_file_body(struct_or_class_p, bindings, generated_class.m_class_scope);
     generated_class.m_cpp_binding_file_body       = generate_class_binding_file_body(struct_or_class_p, bindings);    
     generated_class.m_cpp_register_static_ue_type = FString::Printf(TEXT("SkUEClassBindingHelper::register_static_%s(SkUE%s::ms_u%s_p = FindObjectChecked<%s>(ANY_PACKAGE, TEXT(\"%s\")));"), class_or_struct_text_p, *skookum_class_name, class_or_struct_text_p, class_p ? TEXT("UClass") : TEXT("UStruct"), *struct_or_class_p->GetName());
     generated_class.m_cpp_register_static_sk_type = FString::Printf(TEXT("SkUEClassBindingHelper::add_static_%s_mapping(SkUE%s::initialize_class(0x%08x), SkUE%s::ms_u%s_p);"), class_or_struct_text_p, *skookum_class_name, get_skookum_symbol_id(*skookum_class_name), *skookum_class_name, class_or_struct_text_p);
     }
-
-  return generated_index;
   }
 
 //---------------------------------------------------------------------------------------
@@ -714,20 +778,11 @@ FString FSkookumScriptGenerator::generate_class_binding_file_body(UStruct * stru
 
 //---------------------------------------------------------------------------------------
 
-int32 FSkookumScriptGenerator::generate_enum(UEnum * enum_p, int32 include_priority, uint32 referenced_flags, eClassScope class_scope)
+void FSkookumScriptGenerator::generate_enum(UEnum * enum_p, const TypeGenerationWork & work)
   {
-  // Allocate structure
-  int32 generated_index = m_types_generated.Emplace();
-  GeneratedType & generated_enum = m_types_generated[generated_index];
-
-  FString enum_type_name = get_skookum_class_name(enum_p);
-  const ModuleInfo * module_p = m_targets[class_scope].get_module(enum_p);
-
-  // Remember info about class
-  generated_enum.m_type_p = enum_p;
-  generated_enum.m_sk_name = enum_type_name;
-  generated_enum.m_class_scope = module_p ? module_p->m_scope : ClassScope_engine;
-  generated_enum.m_is_hierarchy_stub = false; // || !module_p;
+  // Note: This is called in parallel for many types so must only modify its own generated type
+  GeneratedType & generated_enum = m_types_generated[work.m_generated_type_index];
+  const FString & enum_type_name = generated_enum.m_sk_name;
 
   // Generate meta file
   generated_enum.m_sk_meta_file_body = generate_class_meta_file_body(enum_p);
@@ -771,8 +826,6 @@ int32 FSkookumScriptGenerator::generate_enum(UEnum * enum_p, int32 include_prior
     generated_enum.m_cpp_register_static_ue_type  = FString::Printf(TEXT("SkUEClassBindingHelper::register_static_enum(SkUE%s::ms_uenum_p = FindObjectChecked<UEnum>(ANY_PACKAGE, TEXT(\"%s\")));"), *enum_type_name, *enum_p->GetName());
     generated_enum.m_cpp_register_static_sk_type  = FString::Printf(TEXT("SkUEClassBindingHelper::add_static_enum_mapping(SkUE%s::ms_class_p = SkBrain::get_class(ASymbol::create_existing(0x%08x)), SkUE%s::ms_uenum_p);"), *enum_type_name, get_skookum_symbol_id(*enum_type_name), *enum_type_name);
     }
-
-  return generated_index;
   }
 
 //---------------------------------------------------------------------------------------
@@ -1067,6 +1120,8 @@ FString FSkookumScriptGenerator::generate_event_script_file_body(eEventCoro whic
       "//---------------------------------------------------------------------------------------\n"
       "// Whenever a `%s` event occurs on this `%s`, run `code` on it.\n"
       "// This coroutine never finishes by itself and can only be terminated externally.\n"
+      "// Events not passing the optional `filter` are ignored without running `code`.\n"
+      "// Events arriving faster than `code` runs are coalesced as set by the optional `queue`.\n"
       "//---------------------------------------------------------------------------------------\n"
       "//\n"),
     TEXT(
@@ -1074,6 +1129,8 @@ FString FSkookumScriptGenerator::generate_event_script_file_body(eEventCoro whic
       "// Whenever a `%s` event occurs on this `%s`, run `code` on it.\n"
       "// If `code` returns `false`, continue waiting for next event,\n"
       "// otherwise, exit and return the event parameters\n"
+      "// Events not passing the optional `filter` are ignored without running `code`.\n"
+      "// Events arriving faster than `code` runs are coalesced as set by the optional `queue`.\n"
       "//---------------------------------------------------------------------------------------\n"
       "//\n"),
     TEXT(
@@ -1101,7 +1158,7 @@ FString FSkookumScriptGenerator::generate_event_script_file_body(eEventCoro whic
     if (num_inputs > 1) coro_body += TEXT("\n ");
     coro_body += TEXT(") ");
     if (which == EventCoro_do_until) coro_body += TEXT("Boolean ");
-    coro_body += TEXT("code");
+    coro_body += TEXT("code, <EventFilter|None> filter: nil, <EventQueuePolicy|None> queue: nil");
     }
   if (delegate_property_p->SignatureFunction->NumParms) coro_body += TEXT(";");
   coro_body += TEXT("\n");
@@ -1125,40 +1182,138 @@ FString FSkookumScriptGenerator::generate_event_binding_code(const FString & cla
     "    {\r\n"
     "    public:\r\n"), *binding.m_property_p->GetName());
   
-  // The callback function
-  generated_code += FString::Printf(TEXT("      void %s("), *binding.m_property_p->GetName());
-  const TCHAR * separator_p = TEXT("");
+  // The raw event payload - boxed into SkInstances only when a coroutine consumes the event
+  int32 param_count = 0;
+  generated_code += TEXT(
+    "      struct FEventPayload\r\n"
+    "        {\r\n");
+  // Objects are referenced weakly since the payload may be queued across a garbage collection
   for (TFieldIterator<UProperty> param_it(binding.m_property_p->SignatureFunction); param_it; ++param_it)
     {
     UProperty * param_p = *param_it;
-    generated_code += FString::Printf(TEXT("%s%s %s"), separator_p, *get_cpp_property_type_name(param_p, false, true, true), *param_p->GetName());
-    separator_p = TEXT(", ");
+    UClass *    weak_class_p = get_event_payload_weak_class(param_p);
+    FString     member_type = get_cpp_property_type_name(param_p);
+    if (weak_class_p)
+      {
+      member_type = FString::Printf(param_p->IsA<UArrayProperty>() ? TEXT("TArray<TWeakObjectPtr<%s>>") : TEXT("TWeakObjectPtr<%s>"), *get_cpp_class_name(weak_class_p));
+      }
+    generated_code += FString::Printf(TEXT("        %s %s;\r\n"), *member_type, *param_p->GetName());
+    ++param_count;
     }
   generated_code += TEXT(
-    ")\r\n"
-    "        {\r\n"
-    "        EventInfo * event_p = alloc_event();\r\n");
-  int32 param_index = 0;
-  if (binding.m_property_p->SignatureFunction->Children)
-    {
+    "        static void unpack(void * payload_p, SkInstance ** args_pp)\r\n"
+    "          {\r\n"
+    "          FEventPayload * this_p = static_cast<FEventPayload *>(payload_p);\r\n");
+  if (param_count)
+    {
+    generated_code += TEXT(
+      "          if (args_pp)\r\n"
+      "            {\r\n");
+    int32 param_index = 0;
     for (TFieldIterator<UProperty> param_it(binding.m_property_p->SignatureFunction); param_it; ++param_it)
       {
       UProperty * param_p = *param_it;
-      bool use_const_cast = false;
-      if (param_p->HasAnyPropertyFlags(CPF_ConstParm))
+      FString     var_name = TEXT("this_p->") + param_p->GetName();
+      if (get_event_payload_weak_class(param_p))
         {
-        eSkTypeID type_id = get_skookum_property_type(param_p, true);
-        use_const_cast = (type_id == FSkookumScriptGeneratorBase::SkTypeID_UObject || type_id == FSkookumScriptGeneratorBase::SkTypeID_UObjectWeakPtr);
+        UArrayProperty * array_property_p = Cast<UArrayProperty>(param_p);
+        if (array_property_p)
+          {
+          // Objects that were destroyed in the meantime turn into null elements
+          var_name = param_p->GetName() + TEXT("_objects");
+          generated_code += FString::Printf(TEXT(
+            "            TArray<%s> %s;\r\n"
+            "            %s.Reserve(this_p->%s.Num());\r\n"
+            "            for (const auto & object : this_p->%s) { %s.Add(object.Get()); }\r\n"),
+            *get_cpp_property_type_name(array_property_p->Inner, true), *var_name,
+            *var_name, *param_p->GetName(),
+            *param_p->GetName(), *var_name);
+          }
+        else
+          {
+          var_name += TEXT(".Get()");
+          }
         }
-      FString argument = use_const_cast ? FString::Printf(TEXT("const_cast<%s>(%s)"), *get_cpp_property_type_name(param_p, false, false, true), *param_p->GetName()) : param_p->GetName();
-      generated_code += FString::Printf(TEXT("        event_p->m_argument_p[SkArg_%d] = %s;\r\n"), ++param_index, *generate_var_to_instance_expression(param_p, argument));
+      generated_code += FString::Printf(TEXT("            args_pp[SkArg_%d] = %s;\r\n"), ++param_index, *generate_var_to_instance_expression(param_p, var_name));
+      }
+    generated_code += TEXT(
+      "            }\r\n");
+    }
+  generated_code += TEXT(
+    "          this_p->~FEventPayload();\r\n"
+    "          }\r\n");
+  generated_code += generate_event_key_code(binding);
+  generated_code += TEXT(
+    "        };\r\n");
+
+  // The native trampoline - copies the raw parameters into the payload ring buffer of a listener
+  FString param_decls;
+  FString param_names;
+  const TCHAR * separator_p = TEXT("");
+  for (TFieldIterator<UProperty> param_it(binding.m_property_p->SignatureFunction); param_it; ++param_it)
+    {
+    UProperty * param_p = *param_it;
+    param_decls += FString::Printf(TEXT(", %s %s"), *get_cpp_property_type_name(param_p, false, true, true), *param_p->GetName());
+    param_names += separator_p + param_p->GetName();
+    separator_p = TEXT(", ");
+    }
+  generated_code += FString::Printf(TEXT(
+    "      static void on_event(SkookumScriptListenerBase * listener_p%s)\r\n"
+    "        {\r\n"
+    "        static_assert(alignof(FEventPayload) <= Payload_alignment, \"Event payload alignment must be supported by the ring buffer!\");\r\n"
+    "        static_assert(%d <= A_COUNT_OF(((EventInfo *)nullptr)->m_argument_p), \"Event arguments must fit in the array!\");\r\n"),
+    *param_decls,
+    param_count);
+  generated_code += generate_event_filter_code(binding);
+  generated_code += FString::Printf(TEXT(
+    "        FEventPayload * payload_p = new (listener_p->alloc_payload(sizeof(FEventPayload), %d, &FEventPayload::unpack, &FEventPayload::get_key)) FEventPayload;\r\n"),
+    param_count);
+  for (TFieldIterator<UProperty> param_it(binding.m_property_p->SignatureFunction); param_it; ++param_it)
+    {
+    UProperty * param_p = *param_it;
+    bool use_const_cast = false;
+    if (param_p->HasAnyPropertyFlags(CPF_ConstParm))
+      {
+      eSkTypeID type_id = get_skookum_property_type(param_p, true);
+      use_const_cast = (type_id == FSkookumScriptGeneratorBase::SkTypeID_UObject || type_id == FSkookumScriptGeneratorBase::SkTypeID_UObjectWeakPtr);
+      }
+    FString argument = use_const_cast ? FString::Printf(TEXT("const_cast<%s>(%s)"), *get_cpp_property_type_name(param_p, false, false, true), *param_p->GetName()) : param_p->GetName();
+    UClass * weak_class_p = get_event_payload_weak_class(param_p);
+    if (!weak_class_p)
+      {
+      generated_code += FString::Printf(TEXT("        payload_p->%s = %s;\r\n"), *param_p->GetName(), *argument);
+      }
+    else if (param_p->IsA<UArrayProperty>())
+      {
+      generated_code += FString::Printf(TEXT(
+        "        payload_p->%s.Reserve(%s.Num());\r\n"
+        "        for (const auto & object : %s) { payload_p->%s.Add(static_cast<%s *>(object)); }\r\n"),
+        *param_p->GetName(), *param_p->GetName(),
+        *param_p->GetName(), *param_p->GetName(), *get_cpp_class_name(weak_class_p));
+      }
+    else
+      {
+      generated_code += FString::Printf(TEXT("        payload_p->%s = static_cast<%s *>(%s);\r\n"), *param_p->GetName(), *get_cpp_class_name(weak_class_p), *argument);
       }
-    generated_code += FString::Printf(TEXT("        static_assert(sizeof(event_p->m_argument_p) >= %d * sizeof(event_p->m_argument_p[0]), \"Event arguments must fit in the array!\");\r\n"), param_index);
     }
-  generated_code += FString::Printf(TEXT("        push_event_and_resume(event_p, %d);\r\n"), param_index);
   generated_code += TEXT(
+    "        listener_p->push_payload_and_resume();\r\n"
     "        }\r\n");
 
+  // The callback function - this listener is the dispatcher, so hand the event to each native listener
+  generated_code += FString::Printf(TEXT(
+    "      void %s(%s)\r\n"
+    "        {\r\n"
+    "        for (SkookumScriptNativeListener * listener_p : get_native_listeners())\r\n"
+    "          {\r\n"
+    "          on_event(listener_p%s%s);\r\n"
+    "          }\r\n"
+    "        }\r\n"),
+    *binding.m_property_p->GetName(),
+    *param_decls.Mid(param_decls.IsEmpty() ? 0 : 2),
+    param_names.IsEmpty() ? TEXT("") : TEXT(", "),
+    *param_names);
+
   // The "Thunk" (glue code between Blueprint scripting engine and the callback function)
   generated_code += FString::Printf(TEXT("      DECLARE_FUNCTION(exec%s)\r\n"), *binding.m_property_p->GetName());
   generated_code += TEXT("        {\r\n");
@@ -1228,19 +1383,29 @@ FString FSkookumScriptGenerator::generate_event_binding_code(const FString & cla
     *binding.m_property_p->GetName(), 
     *binding.m_property_p->GetName());
 
+  // The native listener install callback - shares one dispatcher per object and delegate
+  generated_code += FString::Printf(TEXT(
+    "      static void install_native(UObject * obj_p, SkookumScriptNativeListener * listener_p)\r\n"
+    "        {\r\n"
+    "        add_dispatched_listener(obj_p, ms_name, listener_p, &USkookumScriptListener_%s::install, &USkookumScriptListener_%s::uninstall);\r\n"
+    "        }\r\n"),
+    *binding.m_property_p->GetName(),
+    *binding.m_property_p->GetName());
+
   // The name
   generated_code += TEXT("    static FName ms_name;\r\n");
   generated_code += TEXT("    };\r\n");
   generated_code += FString::Printf(TEXT("  FName USkookumScriptListener_%s::ms_name(TEXT(\"%s\"));\r\n\r\n"), *binding.m_property_p->GetName(), *binding.m_property_p->GetName());
 
-  // 2) Create coroutine implementations
-  FString install_args = FString::Printf(TEXT("&USkookumScriptListener_%s::install, &USkookumScriptListener_%s::uninstall"), *binding.m_property_p->GetName(), *binding.m_property_p->GetName());
+  // 2) Create coroutine implementations - each coroutine gets a pooled native listener, the
+  // dispatcher unhooks it when freed so there is no unregister callback
+  FString install_args = FString::Printf(TEXT("&USkookumScriptListener_%s::install_native, nullptr"), *binding.m_property_p->GetName());
   for (int32 i = 0; i < EventCoro__count; ++i)
     {
     generated_code += FString::Printf(TEXT(
       "  static bool coro%s(SkInvokedCoroutine * scope_p)\r\n"
       "    {\r\n"
-      "    return USkookumScriptListener::%s;\r\n"
+      "    return SkookumScriptNativeListener::%s;\r\n"
       "    }\r\n"), 
       *FString::Printf(ms_event_coro_fmts_pp[i], *binding.m_script_name_base),
       *FString::Printf(ms_event_coro_impl_fmts_pp[i], *install_args)
@@ -1252,6 +1417,123 @@ FString FSkookumScriptGenerator::generate_event_binding_code(const FString & cla
   return generated_code;
   }
 
+//---------------------------------------------------------------------------------------
+// Generate code dropping events that do not pass the event filter of the listener before
+// anything is queued - tests the raw callback parameters
+FString FSkookumScriptGenerator::generate_event_filter_code(const EventBinding & binding)
+  {
+  FString generated_code = TEXT(
+    "        FSkookumScriptEventFilter & filter = listener_p->get_filter();\r\n"
+    "        if (filter.is_active())\r\n"
+    "          {\r\n"
+    "          bool pass_b;\r\n"
+    "          switch (filter.get_arg_idx())\r\n"
+    "            {\r\n");
+
+  int32 param_index = 0;
+  for (TFieldIterator<UProperty> param_it(binding.m_property_p->SignatureFunction); param_it; ++param_it, ++param_index)
+    {
+    UProperty * param_p = *param_it;
+    FString test;
+    switch (get_skookum_property_type(param_p, true))
+      {
+      case SkTypeID_Integer:
+      case SkTypeID_Real:           test = FString::Printf(TEXT("filter.test_scalar(float(%s))"), *param_p->GetName()); break;
+      case SkTypeID_Vector3:        test = FString::Printf(TEXT("filter.test_vector(%s)"), *param_p->GetName()); break;
+      case SkTypeID_UObject:        test = FString::Printf(TEXT("filter.test_object(%s)"), *param_p->GetName()); break;
+      case SkTypeID_UObjectWeakPtr: test = FString::Printf(TEXT("filter.test_object(%s.Get())"), *param_p->GetName()); break;
+      case SkTypeID_UStruct:
+        {
+        UStructProperty * struct_property_p = Cast<UStructProperty>(param_p);
+        if (struct_property_p && struct_property_p->Struct->GetName() == TEXT("HitResult"))
+          {
+          test = FString::Printf(TEXT("filter.test_hit(%s)"), *param_p->GetName());
+          }
+        }
+        break;
+      default: break;
+      }
+    if (!test.IsEmpty())
+      {
+      generated_code += FString::Printf(TEXT("            case %d: pass_b = %s; break;\r\n"), param_index, *test);
+      }
+    }
+
+  generated_code += TEXT(
+    "            default: pass_b = filter.test_unsupported(); break;\r\n"
+    "            }\r\n"
+    "          if (!pass_b) return;\r\n"
+    "          }\r\n");
+
+  return generated_code;
+  }
+
+//---------------------------------------------------------------------------------------
+// Generate the payload function getting an argument as key for the dedupe queue policy -
+// objects, integers, enums, booleans and names can serve as key
+FString FSkookumScriptGenerator::generate_event_key_code(const EventBinding & binding)
+  {
+  FString cases;
+  int32 param_index = 0;
+  for (TFieldIterator<UProperty> param_it(binding.m_property_p->SignatureFunction); param_it; ++param_it, ++param_index)
+    {
+    UProperty * param_p = *param_it;
+    FString key;
+    switch (get_skookum_property_type(param_p, true))
+      {
+      case SkTypeID_Integer:
+      case SkTypeID_Boolean:
+      case SkTypeID_Enum:           key = FString::Printf(TEXT("uint64(this_p->%s)"), *param_p->GetName()); break;
+      case SkTypeID_UObject:
+      case SkTypeID_UObjectWeakPtr: key = FString::Printf(TEXT("uint64(UPTRINT(this_p->%s.Get()))"), *param_p->GetName()); break;
+      case SkTypeID_Name:           key = FString::Printf(TEXT("(uint64(uint32(this_p->%s.GetComparisonIndex())) << 32u) | uint32(this_p->%s.GetNumber())"), *param_p->GetName(), *param_p->GetName()); break;
+      default: break;
+      }
+    if (!key.IsEmpty())
+      {
+      cases += FString::Printf(TEXT("            case %d: return %s;\r\n"), param_index, *key);
+      }
+    }
+
+  FString generated_code = TEXT(
+    "        static uint64 get_key(const void * payload_p, uint32_t arg_idx)\r\n"
+    "          {\r\n");
+  if (!cases.IsEmpty())
+    {
+    generated_code += TEXT(
+      "          const FEventPayload * this_p = static_cast<const FEventPayload *>(payload_p);\r\n"
+      "          switch (arg_idx)\r\n"
+      "            {\r\n");
+    generated_code += cases;
+    generated_code += TEXT(
+      "            default: break;\r\n"
+      "            }\r\n");
+    }
+  generated_code += TEXT(
+    "          return Key_unsupported;\r\n"
+    "          }\r\n");
+
+  return generated_code;
+  }
+
+//---------------------------------------------------------------------------------------
+// Gets the class of the objects an event payload member must reference weakly - i.e. of an
+// object or class parameter or of the elements of an array of them - or nullptr if the
+// parameter is copied as is
+
+UClass * FSkookumScriptGenerator::get_event_payload_weak_class(UProperty * param_p)
+  {
+  UArrayProperty * array_property_p = Cast<UArrayProperty>(param_p);
+  UProperty *      object_param_p = array_property_p ? array_property_p->Inner : param_p;
+
+  eSkTypeID             type_id = get_skookum_property_type(object_param_p, true);
+  UObjectPropertyBase * object_property_p = Cast<UObjectPropertyBase>(object_param_p);
+
+  return (object_property_p && (type_id == SkTypeID_UObject || type_id == SkTypeID_UClass))
+    ? object_property_p->PropertyClass
+    : nullptr;
+  }
+
 //---------------------------------------------------------------------------------------
 
 FString FSkookumScriptGenerator::generate_routine_script_parameters(UFunction * function_p, int32 indent_spaces, FString * out_return_type_name_p, int32 * out_num_inputs_p)
@@ -2361,6 +2643,12 @@ void FSkookumScriptGenerator::on_property_referenced(UProperty * prop_p, int32 i
 
 void FSkookumScriptGenerator::request_generate_type(UField * type_p, int32 include_priority, uint32 referenced_flags)
   {
+  // All types were already requested during discovery - generation runs in parallel and must not modify the list
+  if (m_phase == Phase_generating)
+    {
+    return;
+    }
+
   // Add it or consolidate include path
   TypeToGenerate * type_to_generate_p;
   int32 * existing_index_p = m_types_to_generate_lookup.Find(type_p);
@@ -55,6 +55,19 @@ class FSkookumScriptGeneratorBase
       FSuperClassEntry(const FString & name, UStruct * class_or_struct_p) : m_name(name), m_class_or_struct_p(class_or_struct_p) {}
       };
 
+    // What is known about a generated file, used to skip regenerating files that did not change
+    struct FFileManifestEntry
+      {
+      uint32    m_content_hash;   // CRC of the contents as generated
+      int32     m_content_length; // Length of the contents as generated
+      FDateTime m_time_stamp;     // Time stamp of the file on disk when last written or verified
+
+      FFileManifestEntry() : m_content_hash(0), m_content_length(0) {}
+      explicit FFileManifestEntry(const FString & contents) : m_content_hash(FCrc::StrCrc32(*contents)), m_content_length(contents.Len()) {}
+
+      bool is_same_content(const FFileManifestEntry & other) const { return m_content_hash == other.m_content_hash && m_content_length == other.m_content_length; }
+      };
+
     // (keep these in sync with the same enum in SkTextProgram.hpp)
     enum ePathDepth
       {
@@ -78,11 +91,16 @@ class FSkookumScriptGeneratorBase
     //---------------------------------------------------------------------------------------
     // Methods
 
+                          FSkookumScriptGeneratorBase() : m_file_manifest_dirty(false) {}
+
     static FString        get_or_create_project_file(const FString & ue_project_directory_path, const TCHAR * project_name_p, bool * created_p = nullptr);
     bool                  compute_scripts_path_depth(FString project_ini_file_path, const FString & overlay_name);
     void                  save_text_file(const FString & file_path, const FString & contents);
     bool                  save_text_file_if_changed(const FString & file_path, const FString & new_file_contents); // Helper to change a file only if needed
     void                  flush_saved_text_files(tSourceControlCheckoutFunc checkout_f = nullptr); // Puts generated files into place after all code generation is done
+    void                  set_file_manifest_path(const FString & manifest_file_path); // Loads manifest of previously generated files and keeps it up to date from now on
+    void                  save_file_manifest(); // Writes manifest back to disk if it changed
+    void                  remove_file_manifest_entries(const FString & directory_path); // Forgets about all files in and below a folder
 
     static bool           is_property_type_supported(UProperty * property_p);
     static bool           is_struct_type_supported(UStruct * struct_p);
@@ -129,5 +147,9 @@ class FSkookumScriptGeneratorBase
     FString               m_overlay_path;       // Folder where to place generated script files
     int32                 m_overlay_path_depth; // Amount of super classes until we start flattening the script file hierarchy due to the evil reign of Windows MAX_PATH. 1 = everything is right under 'Object', 0 is not allowed, -1 means "no limit" and -2 means single archive file
 
-    TArray<FString>       m_temp_file_paths;    // Keep track of temp files generated by save_files_if_changed()
+    TMap<FString, FFileManifestEntry> m_temp_files;  // Keep track of temp files generated by save_text_file_if_changed()
+
+    TMap<FString, FFileManifestEntry> m_file_manifest;        // Content hashes of generated files on disk, keyed by file path
+    FString                           m_file_manifest_path;   // Where to persist m_file_manifest - not persisted if empty
+    bool                              m_file_manifest_dirty;  // If m_file_manifest changed since it was last saved
   };
@@ -193,10 +193,31 @@ void FSkookumScriptGeneratorBase::save_text_file(const FString & file_path, cons
 
 bool FSkookumScriptGeneratorBase::save_text_file_if_changed(const FString & file_path, const FString & new_file_contents)
   {
-  FString original_file_local;
-  FFileHelper::LoadFileToString(original_file_local, *file_path);
+  FFileManifestEntry new_entry(new_file_contents);
+  bool has_changed;
+
+  // If the file has not been touched since we last wrote or verified it, the manifest knows its contents
+  const FFileManifestEntry * known_entry_p = m_file_manifest.Find(file_path);
+  if (known_entry_p && IFileManager::Get().GetTimeStamp(*file_path) == known_entry_p->m_time_stamp)
+    {
+    has_changed = !known_entry_p->is_same_content(new_entry);
+    }
+  else
+    {
+    // Unknown file - compare against what's on disk
+    FString original_file_local;
+    FFileHelper::LoadFileToString(original_file_local, *file_path);
+
+    has_changed = original_file_local.Len() == 0 || FCString::Strcmp(*original_file_local, *new_file_contents);
+    if (!has_changed)
+      {
+      // Remember so we don't have to load it next time
+      new_entry.m_time_stamp = IFileManager::Get().GetTimeStamp(*file_path);
+      m_file_manifest.Add(file_path, new_entry);
+      m_file_manifest_dirty = true;
+      }
+    }
 
-  const bool has_changed = original_file_local.Len() == 0 || FCString::Strcmp(*original_file_local, *new_file_contents);
   if (has_changed)
     {
     // save the updated version to a tmp file so that the user can see what will be changing
@@ -210,7 +231,7 @@ bool FSkookumScriptGeneratorBase::save_text_file_if_changed(const FString & file
       }
     else
       {
-      m_temp_file_paths.AddUnique(temp_file_path);
+      m_temp_files.Add(temp_file_path, new_entry);
       }
     }
 
@@ -222,14 +243,22 @@ bool FSkookumScriptGeneratorBase::save_text_file_if_changed(const FString & file
 void FSkookumScriptGeneratorBase::flush_saved_text_files(tSourceControlCheckoutFunc checkout_f)
   {
   // Rename temp files
-  for (auto & temp_file_path : m_temp_file_paths)
+  for (auto & temp_file : m_temp_files)
     {
-    FString file_path = temp_file_path.Replace(TEXT(".tmp"), TEXT(""));
+    const FString & temp_file_path = temp_file.Key;
+    FString file_path = temp_file_path.LeftChop(4); // Remove ".tmp"
     IFileManager::Get().Delete(*file_path, false, true, true); // Delete potentially existing version of the file
     if (!IFileManager::Get().Move(*file_path, *temp_file_path, true, true)) // Move new file into its place
       {
       report_error(FString::Printf(TEXT("Couldn't write file '%s'"), *file_path));
+      m_file_manifest.Remove(file_path);
       }
+    else
+      {
+      FFileManifestEntry & entry = m_file_manifest.Add(file_path, temp_file.Value);
+      entry.m_time_stamp = IFileManager::Get().GetTimeStamp(*file_path);
+      }
+    m_file_manifest_dirty = true;
     // If source control function provided, make sure file is checked out from source control
     if (checkout_f)
       {
@@ -237,7 +266,84 @@ void FSkookumScriptGeneratorBase::flush_saved_text_files(tSourceControlCheckoutF
       }
     }
 
-  m_temp_file_paths.Reset();
+  m_temp_files.Reset();
+
+  save_file_manifest();
+  }
+
+//---------------------------------------------------------------------------------------
+// Manifest file format is one line per file: <content hash> <content length> <time stamp ticks> <file path>
+
+void FSkookumScriptGeneratorBase::set_file_manifest_path(const FString & manifest_file_path)
+  {
+  if (manifest_file_path == m_file_manifest_path)
+    {
+    return;
+    }
+
+  m_file_manifest.Reset();
+  m_file_manifest_path = manifest_file_path;
+  m_file_manifest_dirty = false;
+
+  TArray<FString> lines;
+  if (m_file_manifest_path.IsEmpty() || !FFileHelper::LoadANSITextFileToStrings(*m_file_manifest_path, nullptr, lines))
+    {
+    return;
+    }
+
+  for (const FString & line : lines)
+    {
+    TArray<FString> fields;
+    if (line.ParseIntoArray(fields, TEXT(" "), true) < 4)
+      {
+      continue;
+      }
+
+    FFileManifestEntry entry;
+    entry.m_content_hash = uint32(FCString::Strtoui64(*fields[0], nullptr, 16));
+    entry.m_content_length = FCString::Atoi(*fields[1]);
+    entry.m_time_stamp = FDateTime(FCString::Atoi64(*fields[2]));
+    // File path is the rest of the line as it might contain spaces
+    int32 path_pos = fields[0].Len() + fields[1].Len() + fields[2].Len() + 3;
+    m_file_manifest.Add(line.Mid(path_pos), entry);
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+
+void FSkookumScriptGeneratorBase::save_file_manifest()
+  {
+  if (!m_file_manifest_dirty || m_file_manifest_path.IsEmpty())
+    {
+    return;
+    }
+
+  FString manifest;
+  for (auto & file : m_file_manifest)
+    {
+    manifest += FString::Printf(TEXT("%08x %d %lld %s\r\n"), file.Value.m_content_hash, file.Value.m_content_length, file.Value.m_time_stamp.GetTicks(), *file.Key);
+    }
+
+  // Silent failure - all we lose is speed
+  if (FFileHelper::SaveStringToFile(manifest, *m_file_manifest_path, FFileHelper::EEncodingOptions::ForceAnsi))
+    {
+    m_file_manifest_dirty = false;
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+
+void FSkookumScriptGeneratorBase::remove_file_manifest_entries(const FString & directory_path)
+  {
+  const FString path_prefix = directory_path / TEXT("");
+  for (auto iter = m_file_manifest.CreateIterator(); iter; ++iter)
+    {
+    if (iter.Key().StartsWith(path_prefix))
+      {
+      iter.RemoveCurrent();
+      m_file_manifest_dirty = true;
+      }
+    }
   }
 
 //---------------------------------------------------------------------------------------
@@ -13,9 +13,13 @@
 
 #include "SkUEActor.hpp"
 #include "SkUEEntity.hpp"
+#include "../SkUEBlueprintInterface.hpp"
 #include "../SkUERuntime.hpp"
 #include "../SkUEUtils.hpp"
+#include "VectorMath/SkVector3.hpp"
+#include <SkookumScript/SkInteger.hpp>
 #include <SkookumScript/SkList.hpp>
+#include <SkookumScript/SkSymbol.hpp>
 #include "UObjectHash.h"
 
 //=======================================================================================
@@ -184,12 +188,64 @@ namespace SkUEActor_Impl
       }
     }
 
+  //---------------------------------------------------------------------------------------
+  // Actor@locations(List{Actor} actors) List{Vector3}
+  static void mthdc_locations(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    if (result_pp) // Do nothing if result not desired
+      {
+      const SkInstanceList & actors = scope_p->get_arg<SkList>(SkArg_1);
+      uint32_t               count  = actors.get_length();
+
+      SkInstance *          instance_p = SkList::new_instance(count);
+      APArray<SkInstance> & instances  = instance_p->as<SkList>().get_instances();
+      SkInstance **         actors_pp  = actors.get_array();
+      for (uint32_t idx = 0u; idx < count; idx++)
+        {
+        // One location per actor so indexes match - origin if the actor is gone
+        AActor * actor_p = actors_pp[idx]->as<SkUEActor>();
+
+        // This instance is already refcounted so directly append to underlying array
+        instances.append(*SkVector3::new_instance(actor_p ? actor_p->GetActorLocation() : FVector::ZeroVector));
+        }
+      *result_pp = instance_p;
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // Actor@trigger_event(List{Actor} actors, Symbol event_name, List args) Integer
+  static void mthdc_trigger_event(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    SkClass *              class_p    = ((SkMetaClass *)scope_p->get_topmost_scope())->get_class_info();
+    const ASymbol &        event_name = scope_p->get_arg<SkSymbol>(SkArg_2);
+    SkMethodBase *         method_p   = class_p->find_instance_method_inherited(event_name);
+    const SkInstanceList & actors     = scope_p->get_arg<SkList>(SkArg_1);
+    const SkInstanceList & args       = scope_p->get_arg<SkList>(SkArg_3);
+
+    uint32_t count = 0u;
+    if (method_p)
+      {
+      count = SkUEBlueprintInterface::get()->trigger_event(method_p, actors.get_array(), actors.get_length(), args.get_array(), args.get_length());
+      }
+    else
+      {
+      SK_ERRORX(a_str_format("Tried to trigger Blueprint event '%s' on class '%s', but it has no such method!", event_name.as_cstr_dbg(), class_p->get_name_cstr_dbg()));
+      }
+
+    if (result_pp) // Do nothing if result not desired
+      {
+      *result_pp = SkInteger::new_instance(count);
+      }
+    }
+
   static const SkClass::MethodInitializerFunc methods_c2[] =
     {
       { "find_named",       mthdc_find_named },
       { "named",            mthdc_named },
       { "instances",        mthdc_instances },
       { "instances_first",  mthdc_instances_first },
+      { "locations",        mthdc_locations },
+      { "trigger_event",    mthdc_trigger_event },
     };
 
   } // SkUEActor_Impl
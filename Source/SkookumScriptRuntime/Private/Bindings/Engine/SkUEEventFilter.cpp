@@ -0,0 +1,93 @@
+//=======================================================================================
+// SkookumScript Plugin for Unreal Engine 4
+// Copyright (c) 2015 Agog Labs Inc. All rights reserved.
+//
+// SkookumScript EventFilter (= FSkookumScriptEventFilter) class
+//=======================================================================================
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include "SkUEEventFilter.hpp"
+#include "SkUEClassBinding.hpp"
+
+#include <SkUEEntity.generated.hpp>
+
+#include <SkookumScript/SkInteger.hpp>
+#include <SkookumScript/SkReal.hpp>
+
+//=======================================================================================
+// Method Definitions
+//=======================================================================================
+
+namespace SkUEEventFilter_Impl
+  {
+
+  //---------------------------------------------------------------------------------------
+  // Sets the argument index common to all filters
+  static FSkookumScriptEventFilter * construct_filter(SkInvokedMethod * scope_p, FSkookumScriptEventFilter::eKind kind)
+    {
+    SkIntegerType arg_idx = scope_p->get_arg<SkInteger>(SkArg_1);
+    SK_ASSERTX(arg_idx >= 0, a_str_format("Invalid event argument index %d.", arg_idx));
+
+    FSkookumScriptEventFilter * filter_p = &scope_p->get_this()->construct<SkUEEventFilter>();
+    filter_p->m_kind    = kind;
+    filter_p->m_arg_idx = uint32_t(FMath::Max<SkIntegerType>(arg_idx, 0));
+    return filter_p;
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   EventFilter@!is_a(Integer arg, <Entity> entity_class) EventFilter
+  static void mthd_ctor_is_a(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    FSkookumScriptEventFilter * filter_p = construct_filter(scope_p, FSkookumScriptEventFilter::Kind_class);
+    SkClass * class_p = ((SkMetaClass *)scope_p->get_arg(SkArg_2))->get_class_info();
+    filter_p->m_class_p = SkUEClassBindingHelper::get_ue_class_from_sk_class(class_p);
+    SK_ASSERTX(filter_p->m_class_p, a_cstr_format("The UE4 equivalent of class type '%s' is not known to SkookumScript.", class_p->get_name_cstr_dbg()));
+    if (!filter_p->m_class_p)
+      {
+      filter_p->m_kind = FSkookumScriptEventFilter::Kind_none;
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   EventFilter@!is(Integer arg, Entity entity) EventFilter
+  static void mthd_ctor_is(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    FSkookumScriptEventFilter * filter_p = construct_filter(scope_p, FSkookumScriptEventFilter::Kind_object);
+    filter_p->m_object_p = scope_p->get_arg<SkUEEntity>(SkArg_2);
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   EventFilter@!at_least(Integer arg, Real min) EventFilter
+  static void mthd_ctor_at_least(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    FSkookumScriptEventFilter * filter_p = construct_filter(scope_p, FSkookumScriptEventFilter::Kind_at_least);
+    filter_p->m_min_value = scope_p->get_arg<SkReal>(SkArg_2);
+    }
+
+  // Array listing all the above methods
+  static const SkClass::MethodInitializerFunc methods_i[] =
+    {
+      { "!is_a",      mthd_ctor_is_a },
+      { "!is",        mthd_ctor_is },
+      { "!at_least",  mthd_ctor_at_least },
+    };
+
+} // namespace
+
+//---------------------------------------------------------------------------------------
+void SkUEEventFilter::register_bindings()
+  {
+  tBindingBase::register_bindings("EventFilter");
+
+  ms_class_p->register_method_func_bulk(SkUEEventFilter_Impl::methods_i, A_COUNT_OF(SkUEEventFilter_Impl::methods_i), SkBindFlag_instance_no_rebind);
+  }
+
+//---------------------------------------------------------------------------------------
+
+SkClass * SkUEEventFilter::get_class()
+  {
+  return ms_class_p;
+  }
@@ -0,0 +1,84 @@
+//=======================================================================================
+// SkookumScript Plugin for Unreal Engine 4
+// Copyright (c) 2015 Agog Labs Inc. All rights reserved.
+//
+// SkookumScript EventQueuePolicy (= FSkookumScriptEventQueuePolicy) class
+//=======================================================================================
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include "SkUEEventQueuePolicy.hpp"
+
+#include <SkookumScript/SkInteger.hpp>
+
+//=======================================================================================
+// Method Definitions
+//=======================================================================================
+
+namespace SkUEEventQueuePolicy_Impl
+  {
+
+  //---------------------------------------------------------------------------------------
+  // Gets a non-negative Integer argument
+  static uint32_t get_count_arg(SkInvokedMethod * scope_p, uint32_t arg_idx)
+    {
+    SkIntegerType count = scope_p->get_arg<SkInteger>(arg_idx);
+    SK_ASSERTX(count >= 0, a_str_format("Invalid event queue policy argument %d - must not be negative.", count));
+    return uint32_t(FMath::Max<SkIntegerType>(count, 0));
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   EventQueuePolicy@!keep_first() EventQueuePolicy
+  static void mthd_ctor_keep_first(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    scope_p->get_this()->construct<SkUEEventQueuePolicy>(FSkookumScriptEventQueuePolicy::Kind_keep_first);
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   EventQueuePolicy@!keep_latest() EventQueuePolicy
+  static void mthd_ctor_keep_latest(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    scope_p->get_this()->construct<SkUEEventQueuePolicy>(FSkookumScriptEventQueuePolicy::Kind_keep_latest);
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   EventQueuePolicy@!dedupe(Integer key_arg, Integer max: 0) EventQueuePolicy
+  static void mthd_ctor_dedupe(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    scope_p->get_this()->construct<SkUEEventQueuePolicy>(FSkookumScriptEventQueuePolicy::Kind_dedupe, get_count_arg(scope_p, SkArg_1), get_count_arg(scope_p, SkArg_2));
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   EventQueuePolicy@!bounded(Integer max) EventQueuePolicy
+  static void mthd_ctor_bounded(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    scope_p->get_this()->construct<SkUEEventQueuePolicy>(FSkookumScriptEventQueuePolicy::Kind_keep_all, 0u, get_count_arg(scope_p, SkArg_1));
+    }
+
+  // Array listing all the above methods
+  static const SkClass::MethodInitializerFunc methods_i[] =
+    {
+      { "!keep_first",  mthd_ctor_keep_first },
+      { "!keep_latest", mthd_ctor_keep_latest },
+      { "!dedupe",      mthd_ctor_dedupe },
+      { "!bounded",     mthd_ctor_bounded },
+    };
+
+} // namespace
+
+//---------------------------------------------------------------------------------------
+void SkUEEventQueuePolicy::register_bindings()
+  {
+  tBindingBase::register_bindings("EventQueuePolicy");
+
+  ms_class_p->register_method_func_bulk(SkUEEventQueuePolicy_Impl::methods_i, A_COUNT_OF(SkUEEventQueuePolicy_Impl::methods_i), SkBindFlag_instance_no_rebind);
+  }
+
+//---------------------------------------------------------------------------------------
+
+SkClass * SkUEEventQueuePolicy::get_class()
+  {
+  return ms_class_p;
+  }
@@ -12,8 +12,10 @@
 //=======================================================================================
 
 #include "SkUEName.hpp"
+#include "../SkUEUtils.hpp"
 #include <SkookumScript/SkBoolean.hpp>
 #include <SkookumScript/SkString.hpp>
+#include <SkookumScript/SkSymbol.hpp>
 
 //=======================================================================================
 // Method Definitions
@@ -29,7 +31,15 @@ namespace SkUEName_Impl
     {
     SkInstance * this_p = scope_p->get_this();
     const AString & str = scope_p->get_arg<SkString>(SkArg_1);
-    this_p->construct<SkUEName>(FName(str.as_cstr()));
+    this_p->construct<SkUEName>(AStringToFName(str));
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Name@!symbol(Symbol name) Name
+  static void mthd_ctor_symbol(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    SkInstance * this_p = scope_p->get_this();
+    this_p->construct<SkUEName>(ASymbolToFName(scope_p->get_arg<SkSymbol>(SkArg_1)));
     }
 
   //---------------------------------------------------------------------------------------
@@ -49,8 +59,19 @@ namespace SkUEName_Impl
     // Do nothing if result not desired
     if (result_pp)
       {
-      const FName & name = scope_p->this_as<SkUEName>();
-      *result_pp = SkString::new_instance(AString(name.GetPlainANSIString()));
+      // Shares the string of the symbol rather than copying the characters of the name
+      *result_pp = SkString::new_instance(FNameToASymbol(scope_p->this_as<SkUEName>()).as_string());
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Name@Symbol() Symbol
+  static void mthd_Symbol(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkSymbol::new_instance(FNameToASymbol(scope_p->this_as<SkUEName>()));
       }
     }
 
@@ -95,7 +116,18 @@ namespace SkUEName_Impl
     if (result_pp)
       {
       const AString & str = scope_p->this_as<SkString>();
-      *result_pp = SkUEName::new_instance(FName(str.as_cstr()));
+      *result_pp = SkUEName::new_instance(AStringToFName(str));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Symbol@Name() Name
+  static void mthd_Symbol_to_Name(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkUEName::new_instance(ASymbolToFName(scope_p->this_as<SkSymbol>()));
       }
     }
 
@@ -103,8 +135,10 @@ namespace SkUEName_Impl
   static const SkClass::MethodInitializerFunc methods_i[] =
     {
       { "!",            mthd_ctor_string },
+      { "!symbol",      mthd_ctor_symbol },
       { "!none",        mthd_ctor_none },
       { "String",       mthd_String },
+      { "Symbol",       mthd_Symbol },
       { "equal?",       mthd_op_equals },
       { "not_equal?",   mthd_op_not_equal },
     };
@@ -120,6 +154,7 @@ void SkUEName::register_bindings()
 
   // Hook up extra String methods
   SkString::get_class()->register_method_func("Name", SkUEName_Impl::mthd_String_to_Name);
+  SkSymbol::get_class()->register_method_func("Name", SkUEName_Impl::mthd_Symbol_to_Name);
   }
 
 //---------------------------------------------------------------------------------------
@@ -0,0 +1,106 @@
+//=======================================================================================
+// SkookumScript Plugin for Unreal Engine 4
+// Copyright (c) 2015 Agog Labs Inc. All rights reserved.
+//
+// Additional bindings for the World (= UWorld) class 
+//=======================================================================================
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include "SkUEWorld.hpp"
+#include "SkookumScriptListener.h"
+#include <SkUEActor.generated.hpp>
+#include "Engine/World.h"
+
+//=======================================================================================
+// Method Definitions
+//=======================================================================================
+
+namespace SkUEWorld_Impl
+  {
+
+  //---------------------------------------------------------------------------------------
+  // Raw event payload of World.OnActorSpawned - the actor is referenced weakly since
+  // the payload may be queued across a garbage collection
+  struct FActorSpawnedPayload
+    {
+    TWeakObjectPtr<AActor> m_actor_p;
+
+    static void unpack(void * payload_p, SkInstance ** args_pp)
+      {
+      FActorSpawnedPayload * this_p = static_cast<FActorSpawnedPayload *>(payload_p);
+      if (args_pp)
+        {
+        args_pp[SkArg_1] = SkUEActor::new_instance(this_p->m_actor_p.Get());
+        }
+      this_p->~FActorSpawnedPayload();
+      }
+
+    static uint64 get_key(const void * payload_p, uint32_t arg_idx)
+      {
+      return (arg_idx == 0u) ? uint64(UPTRINT(static_cast<const FActorSpawnedPayload *>(payload_p)->m_actor_p.Get())) : SkookumScriptListenerBase::Key_unsupported;
+      }
+    };
+
+  //---------------------------------------------------------------------------------------
+  // Trampoline bound to the native World.OnActorSpawned delegate
+  static void on_actor_spawned(AActor * actor_p, SkookumScriptNativeListener * listener_p)
+    {
+    FSkookumScriptEventFilter & filter = listener_p->get_filter();
+    if (filter.is_active() && !(filter.get_arg_idx() == 0u ? filter.test_object(actor_p) : filter.test_unsupported()))
+      {
+      return;
+      }
+
+    FActorSpawnedPayload * payload_p = new (listener_p->alloc_payload(sizeof(FActorSpawnedPayload), 1u, &FActorSpawnedPayload::unpack, &FActorSpawnedPayload::get_key)) FActorSpawnedPayload;
+    payload_p->m_actor_p = actor_p;
+    listener_p->push_payload_and_resume();
+    }
+
+  //---------------------------------------------------------------------------------------
+
+  static void install_actor_spawned(UObject * obj_p, SkookumScriptNativeListener * listener_p)
+    {
+    listener_p->set_delegate_handle(static_cast<UWorld *>(obj_p)->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateStatic(&on_actor_spawned, listener_p)));
+    }
+
+  //---------------------------------------------------------------------------------------
+
+  static void uninstall_actor_spawned(UObject * obj_p, SkookumScriptNativeListener * listener_p)
+    {
+    static_cast<UWorld *>(obj_p)->RemoveOnActorSpawnedHandler(listener_p->get_delegate_handle());
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   World@_on_actor_spawned_do((Actor actor) code, <EventFilter|None> filter: nil, <EventQueuePolicy|None> queue: nil)
+  static bool coro_on_actor_spawned_do(SkInvokedCoroutine * scope_p)
+    {
+    return SkookumScriptNativeListener::coro_on_event_do(scope_p, &install_actor_spawned, &uninstall_actor_spawned, false);
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   World@_on_actor_spawned_do_until((Actor actor) Boolean code, <EventFilter|None> filter: nil, <EventQueuePolicy|None> queue: nil; Actor actor)
+  static bool coro_on_actor_spawned_do_until(SkInvokedCoroutine * scope_p)
+    {
+    return SkookumScriptNativeListener::coro_on_event_do(scope_p, &install_actor_spawned, &uninstall_actor_spawned, true);
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   World@_wait_actor_spawned(; Actor actor)
+  static bool coro_wait_actor_spawned(SkInvokedCoroutine * scope_p)
+    {
+    return SkookumScriptNativeListener::coro_wait_event(scope_p, &install_actor_spawned, &uninstall_actor_spawned);
+    }
+
+  } // SkUEWorld_Impl
+
+//---------------------------------------------------------------------------------------
+
+void SkUEWorld_Ext::register_bindings()
+  {
+  ms_class_p->register_coroutine_func("_on_actor_spawned_do",       SkUEWorld_Impl::coro_on_actor_spawned_do,       SkBindFlag_instance_no_rebind);
+  ms_class_p->register_coroutine_func("_on_actor_spawned_do_until", SkUEWorld_Impl::coro_on_actor_spawned_do_until, SkBindFlag_instance_no_rebind);
+  ms_class_p->register_coroutine_func("_wait_actor_spawned",        SkUEWorld_Impl::coro_wait_actor_spawned,        SkBindFlag_instance_no_rebind);
+  }
@@ -0,0 +1,26 @@
+//=======================================================================================
+// SkookumScript Plugin for Unreal Engine 4
+// Copyright (c) 2015 Agog Labs Inc. All rights reserved.
+//
+// Additional bindings for the World (= UWorld) class 
+//=======================================================================================
+
+#pragma once
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include <SkUEWorld.generated.hpp>
+
+//=======================================================================================
+// Global Functions
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+// Bindings for the World (= UWorld) class 
+class SkUEWorld_Ext : public SkUEWorld
+  {
+  public:
+    static void register_bindings();
+  };
@@ -13,6 +13,7 @@
 //=======================================================================================
 
 #include "SkUEBindings.hpp"
+#include "SkUEScheduler.hpp"
 
 #include "VectorMath/SkVector2.hpp"
 #include "VectorMath/SkVector3.hpp"
@@ -23,10 +24,13 @@
 #include "VectorMath/SkColor.hpp"
 
 #include "Engine/SkUEName.hpp"
+#include "Engine/SkUEEventFilter.hpp"
+#include "Engine/SkUEEventQueuePolicy.hpp"
 #include "Engine/SkUEActor.hpp"
 #include "Engine/SkUEActorComponent.hpp"
 #include "Engine/SkUEEntity.hpp"
 #include "Engine/SkUEEntityClass.hpp"
+#include "Engine/SkUEWorld.hpp"
 #include "Engine/SkUESkookumScriptBehaviorComponent.hpp"
 
 //=======================================================================================
@@ -97,7 +101,11 @@ void SkUEBindings::register_all_bindings(SkUEBindingsInterface * project_generat
   SkUEEntityClass_Ext::register_bindings();
   SkUEActor_Ext::register_bindings();
   SkUEActorComponent_Ext::register_bindings();
+  SkUEWorld_Ext::register_bindings();
   SkUESkookumScriptBehaviorComponent::register_bindings();
   SkUEName::register_bindings();
   SkUEName::get_class()->register_raw_accessor_func(&SkUEClassBindingHelper::access_raw_data_struct<SkUEName>);
+  SkUEEventFilter::register_bindings();
+  SkUEEventQueuePolicy::register_bindings();
+  SkUEScheduler::register_bindings();
   }
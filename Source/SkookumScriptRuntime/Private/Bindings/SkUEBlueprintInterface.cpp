@@ -14,6 +14,7 @@
 #include "VectorMath/SkTransform.hpp"
 #include "Engine/SkUEEntity.hpp"
 #include "Engine/SkUEActor.hpp"
+#include "SkUEProfiler.hpp"
 #include "SkUEUtils.hpp"
 #include <SkookumScript/SkExpressionBase.hpp>
 #include <SkookumScript/SkInvokedCoroutine.hpp>
@@ -36,12 +37,16 @@ SkUEBlueprintInterface::SkUEBlueprintInterface()
   m_struct_vector3_p          = FindObjectChecked<UScriptStruct>(UObject::StaticClass()->GetOutermost(), TEXT("Vector"), false);
   m_struct_rotation_angles_p  = FindObjectChecked<UScriptStruct>(UObject::StaticClass()->GetOutermost(), TEXT("Rotator"), false);
   m_struct_transform_p        = FindObjectChecked<UScriptStruct>(UObject::StaticClass()->GetOutermost(), TEXT("Transform"), false);
+
+  FCoreUObjectDelegates::PostGarbageCollect.AddRaw(this, &SkUEBlueprintInterface::prune_event_function_map);
   }
 
 //---------------------------------------------------------------------------------------
 
 SkUEBlueprintInterface::~SkUEBlueprintInterface()
   {
+  FCoreUObjectDelegates::PostGarbageCollect.RemoveAll(this);
+
   clear();
 
   SK_ASSERTX_NO_THROW(ms_singleton_p == this, "There can be only one instance of this class.");
@@ -60,6 +65,11 @@ void SkUEBlueprintInterface::clear()
 
   // And forget pointers to them 
   m_binding_entry_array.empty();
+  m_binding_index_map.Empty();
+  m_event_function_map.Empty();
+
+  // Nobody to notify at this point
+  m_updated_ue_classes.Empty();
   }
 
 //---------------------------------------------------------------------------------------
@@ -78,35 +88,69 @@ UClass * SkUEBlueprintInterface::reexpose_class(SkClass * sk_class_p, tSkUEOnCla
 
 void SkUEBlueprintInterface::reexpose_class(SkClass * sk_class_p, UClass * ue_class_p, tSkUEOnClassUpdatedFunc * on_class_updated_f)
   {
-  // Keep track of changes
-  int32_t change_count = 0;
-
   // Find existing methods of this class and mark them for delete
+  const ASymbol & sk_class_name = sk_class_p->get_name();
   for (uint32_t i = 0; i < m_binding_entry_array.get_length(); ++i)
     {
     BindingEntry * binding_entry_p = m_binding_entry_array[i];
-    if (binding_entry_p && binding_entry_p->m_sk_class_p == sk_class_p)
+    if (binding_entry_p && binding_entry_p->m_sk_class_name == sk_class_name)
       {
       binding_entry_p->m_marked_for_delete = true;
-      ++change_count;
       }
     }
 
-  // Gather new methods/events
+  // Gather new methods/events - unchanged ones will get unmarked
+  gather_class_bindings(sk_class_p, ue_class_p);
+
+  // Now go and delete anything still marked for delete
+  delete_marked_binding_entries();
+
+  // Invoke callback if anything changed
+  flush_updated_classes(on_class_updated_f);
+  }
+
+//---------------------------------------------------------------------------------------
+// Add or update bindings for all Blueprint-exposed routines of a class
+// Entries that are still current are unmarked for delete, only new or changed ones rebuild their UFunction
+
+void SkUEBlueprintInterface::gather_class_bindings(SkClass * sk_class_p, UClass * ue_class_p)
+  {
   for (auto method_p : sk_class_p->get_instance_methods())
     {
-    change_count += int32_t(try_add_binding_entry(ue_class_p, method_p) >= 0);
+    try_add_binding_entry(ue_class_p, method_p);
     }
   for (auto method_p : sk_class_p->get_class_methods())
     {
-    change_count += int32_t(try_add_binding_entry(ue_class_p, method_p) >= 0);
+    try_add_binding_entry(ue_class_p, method_p);
     }
   for (auto coroutine_p : sk_class_p->get_coroutines())
     {
-    change_count += int32_t(try_add_binding_entry(ue_class_p, coroutine_p) >= 0);
+    try_add_binding_entry(ue_class_p, coroutine_p);
     }
+  }
 
-  // Now go and delete anything still marked for delete
+//---------------------------------------------------------------------------------------
+
+void SkUEBlueprintInterface::gather_class_bindings_recursively(SkClass * sk_class_p)
+  {
+  UClass * ue_class_p = SkUEClassBindingHelper::get_static_ue_class_from_sk_class_super(sk_class_p);
+  if (ue_class_p)
+    {
+    gather_class_bindings(sk_class_p, ue_class_p);
+
+    // Gather sub classes
+    const tSkClasses & sub_classes = sk_class_p->get_subclasses();
+    for (uint32_t i = 0; i < sub_classes.get_length(); ++i)
+      {
+      gather_class_bindings_recursively(sub_classes[i]);
+      }
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+
+void SkUEBlueprintInterface::delete_marked_binding_entries()
+  {
   for (uint32_t i = 0; i < m_binding_entry_array.get_length(); ++i)
     {
     BindingEntry * binding_entry_p = m_binding_entry_array[i];
@@ -115,12 +159,22 @@ void SkUEBlueprintInterface::reexpose_class(SkClass * sk_class_p, UClass * ue_cl
       delete_binding_entry(i);
       }
     }
+  }
 
-  // Invoke callback if anything changed
-  if (on_class_updated_f && change_count > 0)
+//---------------------------------------------------------------------------------------
+// Notify about all UClasses that had UFunctions added or removed, once per class
+
+void SkUEBlueprintInterface::flush_updated_classes(tSkUEOnClassUpdatedFunc * on_class_updated_f)
+  {
+  if (on_class_updated_f)
     {
-    on_class_updated_f->invoke(ue_class_p);
+    for (UClass * ue_class_p : m_updated_ue_classes)
+      {
+      on_class_updated_f->invoke(ue_class_p);
+      }
     }
+
+  m_updated_ue_classes.Reset();
   }
 
 //---------------------------------------------------------------------------------------
@@ -142,11 +196,24 @@ void SkUEBlueprintInterface::reexpose_class_recursively(SkClass * sk_class_p, tS
 
 void SkUEBlueprintInterface::reexpose_all(tSkUEOnClassUpdatedFunc * on_class_updated_f)
   {
-  // Clear out old mappings
-  clear();
+  // Mark all existing mappings for delete - rather than clearing them out, keep those that did not change
+  for (uint32_t i = 0; i < m_binding_entry_array.get_length(); ++i)
+    {
+    BindingEntry * binding_entry_p = m_binding_entry_array[i];
+    if (binding_entry_p)
+      {
+      binding_entry_p->m_marked_for_delete = true;
+      }
+    }
 
   // Traverse Sk classes and gather methods that want to be exposed
-  reexpose_class_recursively(SkUEEntity::get_class(), on_class_updated_f);
+  gather_class_bindings_recursively(SkUEEntity::get_class());
+
+  // Get rid of bindings to routines that went away or changed signature
+  delete_marked_binding_entries();
+
+  // Refresh Blueprints of all classes affected by the changes in one batch
+  flush_updated_classes(on_class_updated_f);
   }
 
 //---------------------------------------------------------------------------------------
@@ -181,6 +248,7 @@ void SkUEBlueprintInterface::exec_method(FFrame & stack, void * const result_p,
     }
   SkInvokedMethod imethod(nullptr, this_p, method_p, a_stack_allocate(method_p->get_invoked_data_array_size(), SkInstance*));
 
+  SKUE_PROFILE_SCOPE(method_p->get_scope()->get_name(), method_p->get_name());
   SKDEBUG_ICALL_SET_INTERNAL(&imethod);
   SKDEBUG_HOOK_SCRIPT_ENTRY(function_entry.m_invokable_name);
 
@@ -287,6 +355,7 @@ void SkUEBlueprintInterface::exec_coroutine(FFrame & stack, void * const result_
   #endif
       {
       // Invoke the coroutine on this_p - might return immediately
+      SKUE_PROFILE_SCOPE(coro_p->get_scope()->get_name(), coro_p->get_name());
       icoroutine_p->on_update();
       }
 
@@ -298,33 +367,141 @@ void SkUEBlueprintInterface::exec_coroutine(FFrame & stack, void * const result_
 // Execute a blueprint event
 void SkUEBlueprintInterface::mthd_trigger_event(SkInvokedMethod * scope_p, SkInstance ** result_pp)
   {
-  const EventEntry & event_entry = static_cast<const EventEntry &>(*ms_singleton_p->m_binding_entry_array[scope_p->get_invokable()->get_user_data()]);
+  int32_t binding_index = scope_p->get_invokable()->get_user_data();
+  const EventEntry & event_entry = static_cast<const EventEntry &>(*ms_singleton_p->m_binding_entry_array[binding_index]);
   SK_ASSERTX(event_entry.m_type == BindingType_Event, "BindingEntry has bad type!");
 
-  // Create parameters on stack
+  SkInstance * this_p = scope_p->get_this();
+  ms_singleton_p->invoke_event(event_entry, binding_index, &this_p, 1u, scope_p->get_data().get_array());
+
+  // No return value
+  if (result_pp) *result_pp = SkBrain::ms_nil_p;
+  return;
+  }
+
+//---------------------------------------------------------------------------------------
+// Trigger a Blueprint event on many actors at once
+// The arguments are converted to K2 parameters only once and then passed to each actor in turn
+//
+// Params:
+//   sk_method_p: Sk method that was exposed to Blueprints as an event
+//   actors_pp: actors to invoke the event on - entries that are not of the event's class
+//     (e.g. nil) or whose actor is gone are skipped
+//   args_pp: one SkInstance per parameter of sk_method_p
+//   num_args: must match the number of parameters of sk_method_p
+// Returns: number of actors the event was invoked on
+uint32_t SkUEBlueprintInterface::trigger_event(SkMethodBase * sk_method_p, SkInstance * const * actors_pp, uint32_t num_actors, SkInstance * const * args_pp, uint32_t num_args)
+  {
+  int32_t binding_index = sk_method_p->get_user_data();
+  const BindingEntry * binding_entry_p = (binding_index < int32_t(m_binding_entry_array.get_length())) ? m_binding_entry_array[binding_index] : nullptr;
+  if (!binding_entry_p || binding_entry_p->m_sk_invokable_p != sk_method_p || binding_entry_p->m_type != BindingType_Event)
+    {
+    SK_ERRORX(a_str_format("Method '%s@%s' is not bound as a Blueprint event!", sk_method_p->get_scope()->get_name_cstr_dbg(), sk_method_p->get_name_cstr_dbg()));
+    return 0u;
+    }
+
+  // Arguments usually come from an untyped list so make sure the getters can handle them
+  const EventEntry & event_entry = static_cast<const EventEntry &>(*binding_entry_p);
+  const K2ParamEntry * param_entry_array = event_entry.get_param_entry_array();
+  if (num_args != event_entry.m_num_params)
+    {
+    SK_ERRORX(a_str_format("Blueprint event '%s@%s' takes %u arguments but was given %u!", event_entry.m_sk_class_p->get_name_cstr_dbg(), event_entry.m_invokable_name.as_cstr_dbg(), uint32_t(event_entry.m_num_params), num_args));
+    return 0u;
+    }
+  for (uint32_t i = 0; i < num_args; ++i)
+    {
+    if (!args_pp[i]->get_class()->is_class(*param_entry_array[i].m_sk_class_p))
+      {
+      SK_ERRORX(a_str_format("Argument %u of Blueprint event '%s@%s' must be of class '%s'!", i + 1u, event_entry.m_sk_class_p->get_name_cstr_dbg(), event_entry.m_invokable_name.as_cstr_dbg(), param_entry_array[i].m_sk_class_p->get_name_cstr_dbg()));
+      return 0u;
+      }
+    }
+
+  return invoke_event(event_entry, binding_index, actors_pp, num_actors, args_pp);
+  }
+
+//---------------------------------------------------------------------------------------
+// Marshals the arguments of an event to K2 parameters and invokes it on each actor
+// Returns: number of actors the event was invoked on
+uint32_t SkUEBlueprintInterface::invoke_event(const EventEntry & event_entry, int32_t binding_index, SkInstance * const * actors_pp, uint32_t num_actors, SkInstance * const * args_pp)
+  {
+  // Create parameters on stack - once for all actors
+  // ProcessEvent() copies them into its own frame so the same storage can be passed to each actor
   const K2ParamEntry * param_entry_array = event_entry.get_param_entry_array();
   UFunction * ue_function_p = event_entry.m_ue_function_p.Get(); // Invoke the first one
   uint8_t * k2_params_storage_p = a_stack_allocate(ue_function_p->ParmsSize, uint8_t);
+  // Zeroed memory is a valid empty state for all parameter types we support, e.g. FString
+  FMemory::Memzero(k2_params_storage_p, ue_function_p->ParmsSize);
   for (uint32_t i = 0; i < event_entry.m_num_params; ++i)
     {
     const K2ParamEntry & param_entry = param_entry_array[i];
-    (*param_entry.m_getter_p)(k2_params_storage_p + param_entry.m_offset, scope_p->get_arg(i), param_entry);
+    (*param_entry.m_getter_p)(k2_params_storage_p + param_entry.m_offset, args_pp[i], param_entry);
+    }
+
+  // Invoke K2 script event on all actors
+  uint32_t num_invoked = 0;
+  for (uint32_t actor_idx = 0; actor_idx < num_actors; ++actor_idx)
+    {
+    SkInstance * instance_p = actors_pp[actor_idx];
+    AActor * actor_p = instance_p->get_class()->is_class(*event_entry.m_sk_class_p) ? instance_p->as<SkUEActor>() : nullptr;
+    if (actor_p)
+      {
+      actor_p->ProcessEvent(get_ue_function_to_invoke(event_entry, binding_index, actor_p), k2_params_storage_p);
+      ++num_invoked;
+      }
     }
 
-  // Invoke K2 script event with parameters
-  AActor * actor_p = scope_p->this_as<SkUEActor>();
-  if (!event_entry.m_ue_function_to_invoke_p.IsValid())
+  // Free whatever the parameters allocated, e.g. string buffers
+  for (TFieldIterator<UProperty> param_it(ue_function_p); param_it && (param_it->PropertyFlags & CPF_Parm); ++param_it)
     {
-    // Find Kismet copy of our method to invoke
-    event_entry.m_ue_function_to_invoke_p = actor_p->FindFunctionChecked(*ue_function_p->GetName());
+    param_it->DestroyValue_InContainer(k2_params_storage_p);
+    }
+
+  return num_invoked;
+  }
+
+//---------------------------------------------------------------------------------------
+// Find Kismet copy of an event's UFunction to invoke on a given actor
+// Cached per actor class so actors of different classes sharing an event don't keep looking it up by name
+UFunction * SkUEBlueprintInterface::get_ue_function_to_invoke(const EventEntry & event_entry, int32_t binding_index, AActor * actor_p)
+  {
+  UClass * actor_class_p = actor_p->GetClass();
+
+  // Most of the time it's the same class as last time
+  UFunction * ue_function_to_invoke_p = event_entry.m_ue_function_to_invoke_p.Get();
+  if (!ue_function_to_invoke_p || event_entry.m_ue_class_to_invoke_p.Get() != actor_class_p)
+    {
+    // Look it up in the cache for all classes, and if not there either, find it by name
+    TWeakObjectPtr<UFunction> & cached_function_p = m_event_function_map.FindOrAdd(EventFunctionKey(binding_index, actor_class_p));
+    ue_function_to_invoke_p = cached_function_p.Get();
+    if (!ue_function_to_invoke_p)
+      {
+      ue_function_to_invoke_p = actor_p->FindFunctionChecked(*event_entry.m_ue_function_p->GetName());
+      cached_function_p = ue_function_to_invoke_p;
+      }
+
+    event_entry.m_ue_class_to_invoke_p = actor_class_p;
+    event_entry.m_ue_function_to_invoke_p = ue_function_to_invoke_p;
     }
+
   // Check if this event is actually present in any Blueprint graph
-  SK_ASSERTX(event_entry.m_ue_function_to_invoke_p->Script.Num() > 0, a_str_format("Warning: Call to '%S' on actor '%S' has no effect as no Blueprint event node named '%S' exists in any of its event graphs.", *ue_function_p->GetName(), *actor_p->GetName(), *ue_function_p->GetName()));
-  actor_p->ProcessEvent(event_entry.m_ue_function_to_invoke_p.Get(), k2_params_storage_p);
+  SK_ASSERTX(ue_function_to_invoke_p->Script.Num() > 0, a_str_format("Warning: Call to '%S' on actor '%S' has no effect as no Blueprint event node named '%S' exists in any of its event graphs.", *event_entry.m_ue_function_p->GetName(), *actor_p->GetName(), *event_entry.m_ue_function_p->GetName()));
 
-  // No return value
-  if (result_pp) *result_pp = SkBrain::ms_nil_p;
-  return;
+  return ue_function_to_invoke_p;
+  }
+
+//---------------------------------------------------------------------------------------
+// Forget cached event UFunctions of classes that have been garbage collected
+// so m_event_function_map does not keep growing as Blueprint classes come and go
+void SkUEBlueprintInterface::prune_event_function_map()
+  {
+  for (auto iter = m_event_function_map.CreateIterator(); iter; ++iter)
+    {
+    if (!iter.Key().m_ue_class_p.IsValid() || !iter.Value().IsValid())
+      {
+      iter.RemoveCurrent();
+      }
+    }
   }
 
 //---------------------------------------------------------------------------------------
@@ -352,62 +529,62 @@ bool SkUEBlueprintInterface::try_update_binding_entry(UClass * ue_class_p, SkInv
   {
   SK_ASSERTX(out_binding_index_p, "Must be non-null");
 
-  const tSkParamList & param_list = sk_invokable_p->get_params().get_param_list();
-
   // See if we find any compatible entry already present:  
-  for (int32_t binding_index = 0; binding_index < (int32_t)m_binding_entry_array.get_length(); ++binding_index)
+  // There is no overloading in SkookumScript
+  // Therefore if the key matches we found our slot
+  const int32_t * binding_index_p = m_binding_index_map.Find(BindingKey(sk_invokable_p->get_scope()->get_name(), sk_invokable_p->get_name(), sk_invokable_p->is_class_member()));
+  if (!binding_index_p)
     {
-    BindingEntry * binding_entry_p = m_binding_entry_array[binding_index];
-    if (binding_entry_p
-      && binding_entry_p->m_invokable_name == sk_invokable_p->get_name()
-      && binding_entry_p->m_sk_class_p == sk_invokable_p->get_scope()
-      && binding_entry_p->m_is_class_member == sk_invokable_p->is_class_member())
-      {
-      // There is no overloading in SkookumScript
-      // Therefore if the above matches we found our slot
-      *out_binding_index_p = binding_index;
-
-      // Don't update if UFunction is invalid or UClass no longer valid
-      if (!binding_entry_p->m_ue_function_p.IsValid() || binding_entry_p->m_ue_function_p.Get()->GetOwnerClass() != ue_class_p)
-        {
-        return false;
-        }
+    // No matching entry found at all
+    *out_binding_index_p = -1;
+    return false;
+    }
 
-      // Can't update if signatures don't match
-      if (binding_entry_p->m_num_params != param_list.get_length())
-        {
-        return false;
-        }
-      if (binding_entry_p->m_type == BindingType_Function)
-        {
-        FunctionEntry * function_entry_p = static_cast<FunctionEntry *>(binding_entry_p);
-        if (!have_identical_signatures(param_list, function_entry_p->get_param_entry_array())
-         || function_entry_p->m_result_type.m_sk_class_p != sk_invokable_p->get_params().get_result_class()->get_key_class())
-          {
-          return false;
-          }
-        }
-      else
-        {
-        if (!have_identical_signatures(param_list, static_cast<EventEntry *>(binding_entry_p)->get_param_entry_array()))
-          {
-          return false;
-          }
+  int32_t binding_index = *binding_index_p;
+  *out_binding_index_p = binding_index;
+  BindingEntry * binding_entry_p = m_binding_entry_array[binding_index];
+  SK_ASSERTX(binding_entry_p, "Binding index map is out of sync with binding entry array!");
 
-        // For events, remember which binding index to invoke
-        sk_invokable_p->set_user_data(binding_index);
-        }
+  // Don't update if UFunction is invalid or UClass no longer valid
+  if (!binding_entry_p->m_ue_function_p.IsValid() || binding_entry_p->m_ue_function_p.Get()->GetOwnerClass() != ue_class_p)
+    {
+    return false;
+    }
 
-      // We're good to update
-      binding_entry_p->m_sk_invokable_p = sk_invokable_p; // Update Sk method pointer
-      binding_entry_p->m_marked_for_delete = false; // Keep around
-      return true; // Successfully updated
+  // Can't update if signatures don't match
+  const tSkParamList & param_list = sk_invokable_p->get_params().get_param_list();
+  if (binding_entry_p->m_num_params != param_list.get_length())
+    {
+    return false;
+    }
+  if (binding_entry_p->m_type == BindingType_Function)
+    {
+    FunctionEntry * function_entry_p = static_cast<FunctionEntry *>(binding_entry_p);
+    if (!have_identical_signatures(param_list, function_entry_p->get_param_entry_array())
+     || function_entry_p->m_result_type.m_sk_class_p != sk_invokable_p->get_params().get_result_class()->get_key_class())
+      {
+      return false;
+      }
+    }
+  else
+    {
+    if (!have_identical_signatures(param_list, static_cast<EventEntry *>(binding_entry_p)->get_param_entry_array()))
+      {
+      return false;
       }
+
+    // The Sk method might have been reloaded, so make sure it is bound
+    bind_event_method(static_cast<SkMethodBase *>(sk_invokable_p));
+
+    // For events, remember which binding index to invoke
+    sk_invokable_p->set_user_data(binding_index);
     }
 
-  // No matching entry found at all
-  *out_binding_index_p = -1;
-  return false;
+  // We're good to update
+  binding_entry_p->m_sk_invokable_p = sk_invokable_p; // Update Sk method pointer
+  binding_entry_p->m_sk_class_p = sk_invokable_p->get_scope(); // Class might have been reloaded as well
+  binding_entry_p->m_marked_for_delete = false; // Keep around
+  return true; // Successfully updated
   }
 
 //---------------------------------------------------------------------------------------
@@ -461,6 +638,7 @@ int32_t SkUEBlueprintInterface::add_function_entry(UClass * ue_class_p, SkInvoka
   ParamInfo * param_info_array_p = a_stack_allocate(num_params + 1, ParamInfo);
   UFunction * ue_function_p = build_ue_function(ue_class_p, sk_invokable_p, BindingType_Function, param_info_array_p);
   if (!ue_function_p) return -1;
+  m_updated_ue_classes.AddUnique(ue_class_p);
 
   // Allocate binding entry
   const ParamInfo & return_info = param_info_array_p[num_params];
@@ -506,6 +684,7 @@ int32_t SkUEBlueprintInterface::add_event_entry(UClass * ue_class_p, SkMethodBas
   ParamInfo * param_info_array_p = a_stack_allocate(num_params + 1, ParamInfo);
   UFunction * ue_function_p = build_ue_function(ue_class_p, sk_method_p, BindingType_Event, param_info_array_p);
   if (!ue_function_p) return -1;
+  m_updated_ue_classes.AddUnique(ue_class_p);
 
   // Bind Sk method
   bind_event_method(sk_method_p);
@@ -547,6 +726,9 @@ int32_t SkUEBlueprintInterface::store_binding_entry(BindingEntry * binding_entry
     m_binding_entry_array.set_at(binding_index_to_use, binding_entry_p);
     }
 
+  // Remember binding index for quick lookup on reload
+  m_binding_index_map.Add(binding_entry_p->get_key(), binding_index_to_use);
+
   // Remember binding index to invoke Blueprint events
   binding_entry_p->m_sk_invokable_p->set_user_data(binding_index_to_use);
 
@@ -569,6 +751,7 @@ void SkUEBlueprintInterface::delete_binding_entry(uint32_t binding_index)
       if (binding_entry_p->m_ue_class_p.IsValid())
         {
         UClass * ue_class_p = binding_entry_p->m_ue_class_p.Get();
+        m_updated_ue_classes.AddUnique(ue_class_p);
         // Unlink from its owner class
         ue_class_p->RemoveFunctionFromFunctionMap(ue_function_p);
         // Unlink from the Children list as well
@@ -585,6 +768,18 @@ void SkUEBlueprintInterface::delete_binding_entry(uint32_t binding_index)
       // Destroy the function along with its attached properties
       ue_function_p->MarkPendingKill();
       }
+    // Forget cached UFunctions to invoke as the binding index might get reused by a different event
+    if (binding_entry_p->m_type == BindingType_Event)
+      {
+      for (auto iter = m_event_function_map.CreateIterator(); iter; ++iter)
+        {
+        if (iter.Key().m_binding_index == (int32_t)binding_index)
+          {
+          iter.RemoveCurrent();
+          }
+        }
+      }
+    m_binding_index_map.Remove(binding_entry_p->get_key());
     FMemory::Free(binding_entry_p);
     m_binding_entry_array.set_at(binding_index, nullptr);
     }
@@ -45,6 +45,8 @@ class SkUEBlueprintInterface
     bool      is_skookum_blueprint_function(UFunction * function_p) const;
     bool      is_skookum_blueprint_event(UFunction * function_p) const;
 
+    uint32_t  trigger_event(SkMethodBase * sk_method_p, SkInstance * const * actors_pp, uint32_t num_actors, SkInstance * const * args_pp, uint32_t num_args); // Trigger Blueprint event on many actors, marshaling the arguments only once
+
   protected:
 
     // We place this magic number in the rep offset to be able to tell if a UFunction is an Sk event
@@ -70,10 +72,25 @@ class SkUEBlueprintInterface
       BindingType_Event,     // Call from Sk into Blueprints
       };
 
+    // Key to quickly look up the binding entry of an Sk invokable
+    struct BindingKey
+      {
+      uint32_t  m_class_name_id;
+      uint32_t  m_invokable_name_id;
+      bool      m_is_class_member;
+
+      BindingKey(const ASymbol & class_name, const ASymbol & invokable_name, bool is_class_member)
+        : m_class_name_id(class_name.get_id()), m_invokable_name_id(invokable_name.get_id()), m_is_class_member(is_class_member) {}
+
+      bool operator == (const BindingKey & other) const { return m_class_name_id == other.m_class_name_id && m_invokable_name_id == other.m_invokable_name_id && m_is_class_member == other.m_is_class_member; }
+      friend uint32 GetTypeHash(const BindingKey & key) { return HashCombine(key.m_class_name_id, key.m_invokable_name_id) ^ uint32(key.m_is_class_member); }
+      };
+
     // Keep track of a binding between Blueprints and Sk
     struct BindingEntry
       {
       ASymbol                   m_invokable_name;   // Copy of m_sk_invokable_p->get_name() in case m_sk_invokable_p goes bad
+      ASymbol                   m_sk_class_name;    // Copy of m_sk_invokable_p->get_scope()->get_name() in case the class goes bad across a reload
       SkClass *                 m_sk_class_p;       // Copy of m_sk_invokable_p->get_scope() in case m_sk_invokable_p goes bad
       SkInvokableBase *         m_sk_invokable_p;
       TWeakObjectPtr<UClass>    m_ue_class_p;       // Copy of m_sk_invokable_p->GetOwnerClass() to detect if a deleted UFunction leaves dangling pointers
@@ -85,6 +102,7 @@ class SkUEBlueprintInterface
 
       BindingEntry(SkInvokableBase * sk_invokable_p, UFunction * ue_method_p, uint32_t num_params, eBindingType type)
         : m_invokable_name(sk_invokable_p->get_name())
+        , m_sk_class_name(sk_invokable_p->get_scope()->get_name())
         , m_sk_class_p(sk_invokable_p->get_scope())
         , m_sk_invokable_p(sk_invokable_p)
         , m_ue_class_p(ue_method_p->GetOwnerClass())
@@ -94,6 +112,8 @@ class SkUEBlueprintInterface
         , m_marked_for_delete(false)
         , m_type(type)
         {}
+
+      BindingKey get_key() const { return BindingKey(m_sk_class_name, m_invokable_name, m_is_class_member); }
       };
 
     // Parameter being passed into Sk from Blueprints
@@ -133,7 +153,8 @@ class SkUEBlueprintInterface
     // Event binding (call from Sk into Blueprints)
     struct EventEntry : public BindingEntry
       {
-      mutable TWeakObjectPtr<UFunction> m_ue_function_to_invoke_p; // The copy of our method we actually can invoke
+      mutable TWeakObjectPtr<UClass>    m_ue_class_to_invoke_p;    // Class of the actor we invoked this event on last
+      mutable TWeakObjectPtr<UFunction> m_ue_function_to_invoke_p; // The copy of our method we actually can invoke on m_ue_class_to_invoke_p
 
       EventEntry(SkMethodBase * sk_method_p, UFunction * ue_function_p, uint32_t num_params)
         : BindingEntry(sk_method_p, ue_function_p, num_params, BindingType_Event)
@@ -144,6 +165,18 @@ class SkUEBlueprintInterface
       const K2ParamEntry * get_param_entry_array() const { return (const K2ParamEntry *)(this + 1); }
       };
 
+    // Key to look up the UFunction to invoke for a given event on a given UClass
+    struct EventFunctionKey
+      {
+      int32_t                 m_binding_index;
+      TWeakObjectPtr<UClass>  m_ue_class_p;
+
+      EventFunctionKey(int32_t binding_index, UClass * ue_class_p) : m_binding_index(binding_index), m_ue_class_p(ue_class_p) {}
+
+      bool operator == (const EventFunctionKey & other) const { return m_binding_index == other.m_binding_index && m_ue_class_p == other.m_ue_class_p; }
+      friend uint32 GetTypeHash(const EventFunctionKey & key) { return HashCombine(uint32(key.m_binding_index), GetTypeHash(key.m_ue_class_p)); }
+      };
+
     struct ParamInfo
       {
       UProperty *       m_ue_param_p;
@@ -157,8 +190,15 @@ class SkUEBlueprintInterface
     void                exec_coroutine(FFrame & stack, void * const result_p);
 
     static void         mthd_trigger_event(SkInvokedMethod * scope_p, SkInstance ** result_pp);
+    uint32_t            invoke_event(const EventEntry & event_entry, int32_t binding_index, SkInstance * const * actors_pp, uint32_t num_actors, SkInstance * const * args_pp);
+    UFunction *         get_ue_function_to_invoke(const EventEntry & event_entry, int32_t binding_index, AActor * actor_p);
+    void                prune_event_function_map();
 
     void                reexpose_class(SkClass * sk_class_p, UClass * ue_class_p, tSkUEOnClassUpdatedFunc * on_class_updated_f);
+    void                gather_class_bindings(SkClass * sk_class_p, UClass * ue_class_p);
+    void                gather_class_bindings_recursively(SkClass * sk_class_p);
+    void                delete_marked_binding_entries();
+    void                flush_updated_classes(tSkUEOnClassUpdatedFunc * on_class_updated_f);
     bool                try_update_binding_entry(UClass * ue_class_p, SkInvokableBase * sk_invokable_p, int32_t * out_binding_index_p);
     int32_t             try_add_binding_entry(UClass * ue_class_p, SkInvokableBase * sk_invokable_p);
     int32_t             add_function_entry(UClass * ue_class_p, SkInvokableBase * sk_invokable_p);
@@ -194,11 +234,15 @@ class SkUEBlueprintInterface
     static uint32_t     get_sk_value_struct_ref(void * const result_p, SkInstance * value_p, const TypedName & typed_name);
     static uint32_t     get_sk_value_entity(void * const result_p, SkInstance * value_p, const TypedName & typed_name);
 
-    APArray<BindingEntry> m_binding_entry_array;
+    APArray<BindingEntry>     m_binding_entry_array;
+    TMap<BindingKey, int32_t> m_binding_index_map;    // Binding key -> index into m_binding_entry_array
+    TArray<UClass *>          m_updated_ue_classes;   // UClasses whose UFunctions were added/removed since the last flush_updated_classes()
+
+    TMap<EventFunctionKey, TWeakObjectPtr<UFunction>> m_event_function_map; // Kismet copies of event UFunctions per actor class
 
-    UScriptStruct *       m_struct_vector3_p;
-    UScriptStruct *       m_struct_rotation_angles_p;
-    UScriptStruct *       m_struct_transform_p;
+    UScriptStruct *           m_struct_vector3_p;
+    UScriptStruct *           m_struct_rotation_angles_p;
+    UScriptStruct *           m_struct_transform_p;
 
     static SkUEBlueprintInterface * ms_singleton_p; // Hack, make it easy to access for callbacks
         
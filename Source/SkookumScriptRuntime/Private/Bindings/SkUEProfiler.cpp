@@ -0,0 +1,367 @@
+//=======================================================================================
+// SkookumScript Plugin for Unreal Engine 4
+// Copyright (c) 2015 Agog Labs Inc. All rights reserved.
+//
+// Per-routine script profiler timing the places where the plugin runs script code
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include "SkUEProfiler.hpp"
+
+#ifdef SKOOKUM_PROFILER_UNREAL
+
+#include "ISkookumScriptRuntime.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+
+//=======================================================================================
+// Local Global Functions
+//=======================================================================================
+
+namespace
+{
+
+  //---------------------------------------------------------------------------------------
+  // Appends string to file as UTF-8
+  void write_utf8(FArchive * file_p, const FString & str)
+    {
+    FTCHARToUTF8 str_utf8(*str);
+    file_p->Serialize((void *)str_utf8.Get(), str_utf8.Length());
+    }
+
+  //---------------------------------------------------------------------------------------
+  // Converts a cycle count to milliseconds
+  double cycles_to_msecs(uint64 cycles)
+    {
+    return double(cycles) * FPlatformTime::GetSecondsPerCycle64() * 1000.0;
+    }
+
+} // End unnamed namespace
+
+
+//=======================================================================================
+// Class Data
+//=======================================================================================
+
+bool                                      SkUEProfiler::ms_is_running = false;
+bool                                      SkUEProfiler::ms_is_tracing = false;
+uint64                                    SkUEProfiler::ms_start_cycles = 0u;
+ASymbol                                   SkUEProfiler::ms_symbol_skookum;
+ASymbol                                   SkUEProfiler::ms_symbol_update;
+TArray<SkUEProfiler::Routine>             SkUEProfiler::ms_routines;
+TMap<uint64, int32>                       SkUEProfiler::ms_routine_map;
+TArray<SkUEProfiler::Frame>               SkUEProfiler::ms_stack;
+TArray<SkUEProfiler::TraceEvent>          SkUEProfiler::ms_trace;
+IConsoleObject *                          SkUEProfiler::ms_cmd_start_p = nullptr;
+IConsoleObject *                          SkUEProfiler::ms_cmd_stop_p = nullptr;
+
+
+//=======================================================================================
+// Class Methods
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+// Registers the console commands and starts profiling right away if requested on the
+// command line.
+// Notes:      Call after SkookumScript has been initialized.
+// Modifiers:   static
+void SkUEProfiler::initialize()
+  {
+  ms_symbol_skookum = ASymbol::create("SkookumScript");
+  ms_symbol_update  = ASymbol::create("update");
+
+  ms_cmd_start_p = IConsoleManager::Get().RegisterConsoleCommand(
+    TEXT("sk.ProfileStart"),
+    TEXT("Starts profiling SkookumScript routines - add 'trace' to also record a Chrome trace."),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&SkUEProfiler::cmd_start));
+  ms_cmd_stop_p = IConsoleManager::Get().RegisterConsoleCommand(
+    TEXT("sk.ProfileStop"),
+    TEXT("Stops profiling SkookumScript routines and writes the report to the profiling folder."),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&SkUEProfiler::cmd_stop));
+
+  if (FParse::Param(FCommandLine::Get(), TEXT("SkookumProfile")))
+    {
+    start(FParse::Param(FCommandLine::Get(), TEXT("SkookumProfileTrace")));
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Stops profiling if still running and removes the console commands.
+// Notes:      Call before SkookumScript is shut down.
+// Modifiers:   static
+void SkUEProfiler::deinitialize()
+  {
+  if (ms_is_running)
+    {
+    stop();
+    }
+
+  if (ms_cmd_start_p)
+    {
+    IConsoleManager::Get().UnregisterConsoleObject(ms_cmd_start_p);
+    IConsoleManager::Get().UnregisterConsoleObject(ms_cmd_stop_p);
+    ms_cmd_start_p = nullptr;
+    ms_cmd_stop_p  = nullptr;
+    }
+
+  ms_routines.Empty();
+  ms_routine_map.Empty();
+  ms_stack.Empty();
+  ms_trace.Empty();
+
+  ms_symbol_skookum = ASymbol::ms_null;
+  ms_symbol_update  = ASymbol::ms_null;
+  }
+
+//---------------------------------------------------------------------------------------
+// Discards any previous measurements and starts profiling
+// Arg         trace_b - also record every call for write_trace()
+// Modifiers:   static
+void SkUEProfiler::start(bool trace_b)
+  {
+  if (ms_is_running || ms_symbol_update.is_null())
+    {
+    return;
+    }
+
+  ms_routines.Reset();
+  ms_routine_map.Reset();
+  ms_stack.Reset();
+  ms_trace.Reset();
+
+  ms_is_tracing   = trace_b;
+  ms_start_cycles = FPlatformTime::Cycles64();
+  ms_is_running   = true;
+
+  UE_LOG(LogSkookum, Display, TEXT("SkookumScript profiler started%s."), trace_b ? TEXT(" with trace") : TEXT(""));
+  }
+
+//---------------------------------------------------------------------------------------
+// Stops profiling, writes the report (and trace if recorded) to the profiling folder and
+// logs the routines with the most exclusive time.
+// Modifiers:   static
+void SkUEProfiler::stop()
+  {
+  if (!ms_is_running)
+    {
+    return;
+    }
+
+  // Close anything still on the stack
+  uint64 now_cycles = FPlatformTime::Cycles64();
+  while (ms_stack.Num())
+    {
+    pop_routine(now_cycles);
+    }
+
+  ms_is_running = false;
+
+  FString file_stem = FPaths::ProfilingDir() / TEXT("SkookumScript") / (TEXT("SkProfile-") + FDateTime::Now().ToString());
+
+  write_report(file_stem + TEXT(".csv"));
+
+  if (ms_is_tracing)
+    {
+    write_trace(file_stem + TEXT(".json"));
+    }
+
+  // Log top routines
+  TArray<int32> order;
+  get_routine_order(&order);
+
+  UE_LOG(LogSkookum, Display, TEXT("SkookumScript profiler stopped after %.1f s - top routines by exclusive time:"), cycles_to_msecs(now_cycles - ms_start_cycles) / 1000.0);
+  for (int32 rank = 0; rank < order.Num() && rank < Report_log_count; ++rank)
+    {
+    const Routine & routine = ms_routines[order[rank]];
+    UE_LOG(LogSkookum, Display, TEXT("  %9.3f ms excl %9.3f ms incl %8u calls  %s"),
+      cycles_to_msecs(routine.m_exclusive_cycles),
+      cycles_to_msecs(routine.m_inclusive_cycles),
+      routine.m_calls,
+      *routine.m_name);
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Writes flat report of all routines sorted by exclusive time as CSV
+// Returns:    true if written
+// Modifiers:   static
+bool SkUEProfiler::write_report(const FString & file_path)
+  {
+  FArchive * file_p = IFileManager::Get().CreateFileWriter(*file_path);
+  if (!file_p)
+    {
+    UE_LOG(LogSkookum, Warning, TEXT("Could not write SkookumScript profiler report '%s'."), *file_path);
+    return false;
+    }
+
+  TArray<int32> order;
+  get_routine_order(&order);
+
+  write_utf8(file_p, TEXT("Routine,Calls,Exclusive ms,Inclusive ms,Average us,Max us\n"));
+  for (int32 idx : order)
+    {
+    const Routine & routine = ms_routines[idx];
+    write_utf8(file_p, FString::Printf(TEXT("\"%s\",%u,%.3f,%.3f,%.2f,%.2f\n"),
+      *routine.m_name,
+      routine.m_calls,
+      cycles_to_msecs(routine.m_exclusive_cycles),
+      cycles_to_msecs(routine.m_inclusive_cycles),
+      routine.m_calls ? cycles_to_msecs(routine.m_inclusive_cycles) * 1000.0 / routine.m_calls : 0.0,
+      cycles_to_msecs(routine.m_max_cycles) * 1000.0));
+    }
+
+  file_p->Close();
+  delete file_p;
+
+  UE_LOG(LogSkookum, Display, TEXT("SkookumScript profiler report written to '%s'."), *file_path);
+
+  return true;
+  }
+
+//---------------------------------------------------------------------------------------
+// Writes recorded calls as Chrome trace JSON (complete events) - load with
+// chrome://tracing or any viewer understanding the Trace Event Format.
+// Returns:    true if written
+// Modifiers:   static
+bool SkUEProfiler::write_trace(const FString & file_path)
+  {
+  FArchive * file_p = IFileManager::Get().CreateFileWriter(*file_path);
+  if (!file_p)
+    {
+    UE_LOG(LogSkookum, Warning, TEXT("Could not write SkookumScript profiler trace '%s'."), *file_path);
+    return false;
+    }
+
+  // Names are escaped once rather than per event
+  TArray<FString> names;
+  names.Reserve(ms_routines.Num());
+  for (const Routine & routine : ms_routines)
+    {
+    names.Add(FString::Printf(TEXT("\"name\":\"%s\",\"cat\":\"SkookumScript\""),
+      *routine.m_name.ReplaceCharWithEscapedChar()));
+    }
+
+  double usecs_per_cycle = FPlatformTime::GetSecondsPerCycle64() * 1000000.0;
+  int32  event_count     = ms_trace.Num();
+
+  write_utf8(file_p, TEXT("{\"traceEvents\":[\n"));
+  for (int32 idx = 0; idx < event_count; ++idx)
+    {
+    const TraceEvent & event = ms_trace[idx];
+    write_utf8(file_p, FString::Printf(TEXT("{%s,\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}%s\n"),
+      *names[event.m_routine_idx],
+      double(event.m_start_cycles - ms_start_cycles) * usecs_per_cycle,
+      double(event.m_duration_cycles) * usecs_per_cycle,
+      (idx + 1 < event_count) ? TEXT(",") : TEXT("")));
+    }
+  write_utf8(file_p, TEXT("],\"displayTimeUnit\":\"ms\"}\n"));
+
+  file_p->Close();
+  delete file_p;
+
+  if (event_count >= Trace_events_max)
+    {
+    UE_LOG(LogSkookum, Warning, TEXT("SkookumScript profiler trace was full - only the first %d calls were recorded."), event_count);
+    }
+
+  UE_LOG(LogSkookum, Display, TEXT("SkookumScript profiler trace written to '%s'."), *file_path);
+
+  return true;
+  }
+
+//---------------------------------------------------------------------------------------
+// Opens a frame for a call of a routine - see Scope
+// Modifiers:   static
+void SkUEProfiler::push_routine(const ASymbol & class_name, const ASymbol & member_name)
+  {
+  int32 routine_idx = get_routine_idx(class_name, member_name);
+
+  ms_stack.Add(Frame{routine_idx, FPlatformTime::Cycles64(), 0u});
+  }
+
+//---------------------------------------------------------------------------------------
+// Closes the top frame and accumulates its time
+// Modifiers:   static
+void SkUEProfiler::pop_routine(uint64 now_cycles)
+  {
+  Frame    frame            = ms_stack.Pop(false);
+  uint64   inclusive_cycles = now_cycles - frame.m_start_cycles;
+  Routine & routine         = ms_routines[frame.m_routine_idx];
+
+  routine.m_calls++;
+  routine.m_inclusive_cycles += inclusive_cycles;
+  routine.m_exclusive_cycles += inclusive_cycles - FMath::Min(frame.m_child_cycles, inclusive_cycles);
+  routine.m_max_cycles        = FMath::Max(routine.m_max_cycles, inclusive_cycles);
+
+  if (ms_stack.Num())
+    {
+    ms_stack.Last().m_child_cycles += inclusive_cycles;
+    }
+
+  if (ms_is_tracing && ms_trace.Num() < Trace_events_max)
+    {
+    ms_trace.Add(TraceEvent{frame.m_routine_idx, uint32(ms_stack.Num()), frame.m_start_cycles, inclusive_cycles});
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Finds or adds the measurements of a routine
+// Returns:    index into ms_routines
+// Modifiers:   static
+int32 SkUEProfiler::get_routine_idx(const ASymbol & class_name, const ASymbol & member_name)
+  {
+  uint64 key = (uint64(class_name.get_id()) << 32u) | member_name.get_id();
+
+  int32 * routine_idx_p = ms_routine_map.Find(key);
+  if (routine_idx_p)
+    {
+    return *routine_idx_p;
+    }
+
+  int32 routine_idx = ms_routines.Add(Routine{
+    FString::Printf(TEXT("%s@%s"), ANSI_TO_TCHAR(class_name.as_cstr_dbg()), ANSI_TO_TCHAR(member_name.as_cstr_dbg())),
+    0u, 0u, 0u, 0u});
+  ms_routine_map.Add(key, routine_idx);
+
+  return routine_idx;
+  }
+
+//---------------------------------------------------------------------------------------
+// Gets indexes of all routines sorted by exclusive time - most first
+// Modifiers:   static
+void SkUEProfiler::get_routine_order(TArray<int32> * order_p)
+  {
+  order_p->Reset(ms_routines.Num());
+  for (int32 idx = 0; idx < ms_routines.Num(); ++idx)
+    {
+    order_p->Add(idx);
+    }
+  order_p->Sort([](int32 lhs, int32 rhs) { return ms_routines[lhs].m_exclusive_cycles > ms_routines[rhs].m_exclusive_cycles; });
+  }
+
+//---------------------------------------------------------------------------------------
+// Console command sk.ProfileStart [trace]
+// Modifiers:   static
+void SkUEProfiler::cmd_start(const TArray<FString> & args)
+  {
+  start(args.Num() && args[0] == TEXT("trace"));
+  }
+
+//---------------------------------------------------------------------------------------
+// Console command sk.ProfileStop
+// Modifiers:   static
+void SkUEProfiler::cmd_stop(const TArray<FString> & args)
+  {
+  stop();
+  }
+
+#endif  // SKOOKUM_PROFILER_UNREAL
@@ -0,0 +1,200 @@
+//=======================================================================================
+// SkookumScript Plugin for Unreal Engine 4
+// Copyright (c) 2015 Agog Labs Inc. All rights reserved.
+//
+// Per-routine script profiler timing the places where the plugin runs script code
+//=======================================================================================
+
+#pragma once
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include <AgogCore/ASymbol.hpp>
+#include <SkookumScript/Sk.hpp>
+
+class IConsoleObject;
+
+
+//=======================================================================================
+// Global Macros / Defines
+//=======================================================================================
+
+// Only in Debug and Development builds - and not on lean dedicated servers
+#if (SKOOKUM & SK_DEBUG) && !defined(SK_LEAN_SERVER)
+  #define SKOOKUM_PROFILER_UNREAL
+#endif
+
+// Measures the rest of the enclosing block as a call of _class_name@_member_name
+#ifdef SKOOKUM_PROFILER_UNREAL
+  #define SKUE_PROFILE_SCOPE(_class_name, _member_name)  SkUEProfiler::Scope sk_profile_scope(_class_name, _member_name)
+#else
+  #define SKUE_PROFILE_SCOPE(_class_name, _member_name)  (void(0))
+#endif
+
+
+#ifdef SKOOKUM_PROFILER_UNREAL
+
+//=======================================================================================
+// Global Structures
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+// Measures call counts and inclusive/exclusive time of script code run by the plugin.
+//
+// Each measurement is an SkUEProfiler::Scope (see SKUE_PROFILE_SCOPE()) that starts when
+// the plugin calls into script and ends when the call returns, so no timing is inferred.
+// Scopes are placed in:
+//   - Blueprint calls of script methods and coroutines (`Class@method`) - a coroutine
+//     called from Blueprint is timed up to its first yield
+//   - the per-frame update of each mind (`MindClass@update`) - this is where coroutines
+//     run after their first yield, so the time of script coroutines across updates is
+//     attributed to the class of the mind updating them
+//   - each update of a plugin coroutine such as `_on_x_do()` or `_wait_x()` and each run
+//     of its closure (`Class@_on_x_do`)
+//   - the constructor (`Class@!`) and the on_attach/on_begin_play/on_end_play/on_detach
+//     calls of script instances created by the SkookumScript components
+//   - the update of SkookumScript as a whole (`SkookumScript@update`)
+//
+// Routines are keyed by class and member name symbols, so results are unaffected by
+// scripts being reloaded.  Script code calling script code is not broken down further.
+//
+// Start with `-SkookumProfile` on the command line or with the `sk.ProfileStart` console
+// command and stop with `sk.ProfileStop` - a flat report sorted by exclusive time is then
+// written as CSV to the Saved/Profiling/SkookumScript folder and the top routines are
+// logged.  Adding `-SkookumProfileTrace` or the `trace` argument also records every call
+// as Chrome trace JSON viewable with chrome://tracing.
+//
+// While profiling, SkUEScheduler updates the minds one at a time in a single pass to time
+// each of them.  Cost while not running is a single flag check per scope.  Game thread
+// only.
+class SkUEProfiler
+  {
+  public:
+
+  // Constants
+
+    enum
+      {
+      Trace_events_max = 4 * 1024 * 1024, // Calls recorded in a trace before it is full
+      Report_log_count = 20               // Routines listed in the log when stopped
+      };
+
+  // Nested Structures
+
+    // Measures the lifetime of the scope as one call of a routine
+    class Scope
+      {
+      public:
+        Scope(const ASymbol & class_name, const ASymbol & member_name);
+        ~Scope();
+
+      protected:
+        // Stack depth below this scope or -1 if not measured
+        int32 m_depth;
+      };
+
+  // Class Methods
+
+    static void initialize();
+    static void deinitialize();
+
+    static void start(bool trace_b = false);
+    static void stop();
+    static bool is_running()                       { return ms_is_running; }
+
+    static const ASymbol & get_symbol_skookum()    { return ms_symbol_skookum; }
+    static const ASymbol & get_symbol_update()     { return ms_symbol_update; }
+
+    static bool write_report(const FString & file_path);
+    static bool write_trace(const FString & file_path);
+
+  protected:
+
+  // Nested Structures
+
+    // Accumulated measurements of a routine
+    struct Routine
+      {
+      FString m_name;
+      uint32  m_calls;
+      uint64  m_inclusive_cycles;
+      uint64  m_exclusive_cycles;
+      uint64  m_max_cycles;
+      };
+
+    // Routine on the call stack
+    struct Frame
+      {
+      int32  m_routine_idx;
+      uint64 m_start_cycles;
+      uint64 m_child_cycles;
+      };
+
+    // Single call recorded for the trace
+    struct TraceEvent
+      {
+      int32  m_routine_idx;
+      uint32 m_depth;
+      uint64 m_start_cycles;
+      uint64 m_duration_cycles;
+      };
+
+  // Class Methods
+
+    static void  push_routine(const ASymbol & class_name, const ASymbol & member_name);
+    static void  pop_routine(uint64 now_cycles);
+    static int32 get_routine_idx(const ASymbol & class_name, const ASymbol & member_name);
+    static void  get_routine_order(TArray<int32> * order_p);
+
+    static void cmd_start(const TArray<FString> & args);
+    static void cmd_stop(const TArray<FString> & args);
+
+  // Class Data Members
+
+    static bool                       ms_is_running;
+    static bool                       ms_is_tracing;
+    static uint64                     ms_start_cycles;
+
+    static ASymbol                    ms_symbol_skookum;
+    static ASymbol                    ms_symbol_update;
+
+    static TArray<Routine>            ms_routines;
+    static TMap<uint64, int32>        ms_routine_map;  // (class id << 32 | member id) -> ms_routines index
+    static TArray<Frame>              ms_stack;
+    static TArray<TraceEvent>         ms_trace;
+
+    static IConsoleObject *           ms_cmd_start_p;
+    static IConsoleObject *           ms_cmd_stop_p;
+
+  };  // SkUEProfiler
+
+
+//=======================================================================================
+// Inline Functions
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+
+inline SkUEProfiler::Scope::Scope(const ASymbol & class_name, const ASymbol & member_name) :
+  m_depth(-1)
+  {
+  if (ms_is_running)
+    {
+    m_depth = ms_stack.Num();
+    push_routine(class_name, member_name);
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Ignores scopes already closed by stop() or started before start()
+inline SkUEProfiler::Scope::~Scope()
+  {
+  if (ms_is_running && m_depth >= 0 && ms_stack.Num() > m_depth)
+    {
+    pop_routine(FPlatformTime::Cycles64());
+    }
+  }
+
+#endif  // SKOOKUM_PROFILER_UNREAL
@@ -24,9 +24,10 @@
 // Global Structures
 //=======================================================================================
 
-#if (SKOOKUM & SK_DEBUG)
+#if (SKOOKUM & SK_DEBUG) && !defined(SK_LEAN_SERVER)
 //#ifdef SKOOKUM_REMOTE
-  // Enable remote SkookumIDE for debugging in the SkookumScript Unreal plug-in
+  // Enable remote SkookumIDE for debugging in the SkookumScript Unreal plug-in - never on
+  // lean dedicated servers
   #define SKOOKUM_REMOTE_UNREAL
 #endif
 
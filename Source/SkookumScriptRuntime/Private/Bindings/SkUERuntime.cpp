@@ -17,6 +17,7 @@
 #include "SkUEBindings.hpp"
 #include "SkUEClassBinding.hpp"
 
+#include <AgogCore/ADeferRelease.hpp>
 #include <AgogCore/AMethodArg.hpp>
 #include <SkookumScript/SkClass.hpp>
 
@@ -31,6 +32,16 @@
 namespace
 {
 
+  // Pool sizes of SkookumScriptListenerManager - listeners are UObjects, so they grow in
+  // smaller steps than the events queued on them
+  enum
+    {
+    Listener_pool_init       = 256,
+    Listener_pool_incr       = 64,
+    Listener_event_pool_init = 256,
+    Listener_event_pool_incr = 256
+    };
+
   //---------------------------------------------------------------------------------------
   // Custom Unreal Binary Handle Structure
   struct SkBinaryHandleUE : public SkBinaryHandle
@@ -100,7 +111,7 @@ SkUERuntime::SkUERuntime()
   , m_is_compiled_scripts_bound(false)
   , m_have_game_module(false)
   , m_compiled_file_b(false)
-  , m_listener_manager(256, 256)
+  , m_listener_manager(Listener_pool_init, Listener_pool_incr, Listener_event_pool_init, Listener_event_pool_incr)
   , m_project_generated_bindings_p(nullptr)
   , m_editor_interface_p(nullptr)
   {
@@ -224,6 +235,36 @@ void SkUERuntime::on_bind_routines()
 // Override to run cleanup code before SkookumScript deinitializes its session
 void SkUERuntime::on_pre_deinitialize_sim()
   {
+  // Clean up any instances still pending while their classes are around
+  ADeferRelease::release_all();
+  }
+
+//---------------------------------------------------------------------------------------
+// Lets go of an instance owned by an actor or component that is going away.
+// While a game world is running, the reference is queued on ADeferRelease and dropped
+// within the time budget of a later frame, so that the clean up of the data members and
+// coroutines of many instances - e.g. when a level with lots of actors is streamed out -
+// is spread over several frames rather than all happening at once.
+//
+// #Params:
+//   instance_p: instance to dereference
+void SkUERuntime::dereference_deferred(SkInstance * instance_p)
+  {
+  if (SkUEClassBindingHelper::get_world())
+    {
+    ADeferRelease::post(instance_p, &SkUERuntime::on_release_deferred);
+    }
+  else
+    {
+    instance_p->dereference();
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Called by ADeferRelease to drop the reference queued by dereference_deferred()
+void SkUERuntime::on_release_deferred(void * instance_p)
+  {
+  static_cast<SkInstance *>(instance_p)->dereference();
   }
 
 //---------------------------------------------------------------------------------------
@@ -47,6 +47,8 @@ class SkUERuntime : public SkRuntimeBase
 
     void ensure_static_ue_types_registered();
 
+    void dereference_deferred(SkInstance * instance_p);
+
     // Script Loading / Binding
 
       const FString & get_compiled_path() const;
@@ -92,6 +94,10 @@ class SkUERuntime : public SkRuntimeBase
 
   protected:
 
+    // Class Methods
+
+      static void on_release_deferred(void * instance_p);
+
     // Data Members
 
       bool                m_is_static_ue_types_registered;
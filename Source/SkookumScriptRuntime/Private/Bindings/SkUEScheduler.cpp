@@ -0,0 +1,533 @@
+//=======================================================================================
+// SkookumScript Plugin for Unreal Engine 4
+// Copyright (c) 2015 Agog Labs Inc. All rights reserved.
+//
+// Frame time budget for the script update with priority based load shedding and
+// updates in several tick group phases
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include "SkUEScheduler.hpp"
+
+#include "Stats.h"
+#include "HAL/IConsoleManager.h"
+
+#include <SkookumScript/SkBoolean.hpp>
+#include <SkookumScript/SkBrain.hpp>
+#include <SkookumScript/SkInteger.hpp>
+#include <SkookumScript/SkInvokedMethod.hpp>
+#include <SkookumScript/SkRuntimeBase.hpp>
+
+
+//=======================================================================================
+// Local Global Data
+//=======================================================================================
+
+static TAutoConsoleVariable<float> s_frame_budget_ms(
+  TEXT("sk.FrameBudgetMs"),
+  0.0f,
+  TEXT("Milliseconds per frame SkookumScript may spend updating minds and coroutines before low priority minds are put off to later frames - 0 = no limit."));
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("SkookumScript Deferred Minds"), STAT_SkookumScriptDeferredMinds, STATGROUP_Game);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("SkookumScript Deferred Coroutines"), STAT_SkookumScriptDeferredCoroutines, STATGROUP_Game);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("SkookumScript Deferred Frames Max"), STAT_SkookumScriptDeferredFramesMax, STATGROUP_Game);
+
+
+//=======================================================================================
+// Script Bindings
+//=======================================================================================
+
+namespace SkUEScheduler_Impl
+  {
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Mind@low_priority?() Boolean
+  static void mthd_low_priorityQ(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkBoolean::new_instance(SkUEScheduler::is_low_priority(static_cast<SkMind *>(scope_p->get_this())));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Mind@low_priority_set(Boolean low_priority: true)
+  static void mthd_low_priority_set(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    SkUEScheduler::set_low_priority(static_cast<SkMind *>(scope_p->get_this()), scope_p->get_arg<SkBoolean>(SkArg_1));
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Mind@tick_phase() Integer
+  static void mthd_tick_phase(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkInteger::new_instance(SkUEScheduler::get_phase(static_cast<SkMind *>(scope_p->get_this())));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Mind@tick_phase_set(Integer phase)
+  static void mthd_tick_phase_set(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    SkIntegerType phase = scope_p->get_arg<SkInteger>(SkArg_1);
+
+    SK_ASSERTX(phase >= 0 && phase < SkUEScheduler::Phase__count, a_str_format("Invalid tick phase %d - expected 0 to %d.", phase, SkUEScheduler::Phase__count - 1));
+    SkUEScheduler::set_phase(static_cast<SkMind *>(scope_p->get_this()), SkUEScheduler::ePhase(FMath::Clamp<SkIntegerType>(phase, 0, SkUEScheduler::Phase__count - 1)));
+    }
+
+  // Array listing all the above methods
+  static const SkClass::MethodInitializerFunc methods_i[] =
+    {
+      { "low_priority?",    mthd_low_priorityQ },
+      { "low_priority_set", mthd_low_priority_set },
+      { "tick_phase",       mthd_tick_phase },
+      { "tick_phase_set",   mthd_tick_phase_set },
+    };
+
+  #ifdef SKOOKUM_PROFILER_UNREAL
+
+  //---------------------------------------------------------------------------------------
+  // Lets the profiler update a single mind - otherwise SkMind::on_update() is only called
+  // by SkMind::update_all() which walks all minds
+  struct MindUpdater : public SkMind
+    {
+    static void update(SkMind * mind_p) { (mind_p->*(&MindUpdater::on_update))(); }
+    };
+
+  #endif
+
+  } // namespace
+
+
+//=======================================================================================
+// Method Definitions
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+
+SkUEScheduler::SkUEScheduler() :
+  m_frame(0u),
+  m_low_mind_secs(0.0),
+  m_deferred_minds(0u),
+  m_deferred_coroutines(0u),
+  m_deferred_frames_max(0u)
+  {
+  }
+
+//---------------------------------------------------------------------------------------
+// Updates SkookumScript for one frame within the frame budget - use instead of
+// SkRuntimeBase::update()
+void SkUEScheduler::update(float sim_delta)
+  {
+  m_frame++;
+  m_deferred_minds      = 0u;
+  m_deferred_coroutines = 0u;
+  m_deferred_frames_max = 0u;
+
+  // Let go of the minds held back last frame and hold back the minds of later phases
+  // until update_phase()
+  release_phase_minds();
+  hold_phase_minds(Phase_dispatch, false);
+
+  float budget_ms = s_frame_budget_ms.GetValueOnGameThread();
+  if (budget_ms <= 0.0f)
+    {
+    update_sim(sim_delta);
+    forget_update_frames();
+    }
+  else
+    {
+    double end_time = FPlatformTime::Seconds() + budget_ms * 0.001;
+
+    // Hold back low priority minds - tracked in m_update_frames which keeps them
+    // referenced so they stay valid for the whole frame
+    for (SkMind * mind_p : SkMind::get_updating_minds())
+      {
+      if (is_low_priority(mind_p) && mind_p->is_updatable())
+        {
+        m_held_minds.Add(mind_p);
+        }
+      }
+    for (SkMind * mind_p : m_held_minds)
+      {
+      MindFrames * frames_p = m_update_frames.Find(mind_p);
+
+      if (!frames_p)
+        {
+        // Referenced while tracked so its address cannot be taken over by a new mind
+        mind_p->reference();
+        frames_p = &m_update_frames.Add(mind_p, MindFrames{0u, 0u});
+        }
+
+      frames_p->m_held_frame = m_frame;
+      mind_p->enable_updatable(false);
+      }
+
+    // Advances sim time and updates all high priority minds
+    update_sim(sim_delta);
+
+    // Update as many low priority minds - least recently updated first - as are expected
+    // to fit in the time left, all in a single pass over the minds
+    uint32_t updated_count = 0u;
+    double   start_time    = FPlatformTime::Seconds();
+    if (m_held_minds.Num() && start_time < end_time)
+      {
+      m_held_minds.Sort([this](const SkMind & lhs, const SkMind & rhs)
+        {
+        return m_update_frames.FindChecked(const_cast<SkMind *>(&lhs)).m_updated_frame
+          < m_update_frames.FindChecked(const_cast<SkMind *>(&rhs)).m_updated_frame;
+        });
+
+      // Estimate from the average cost of a low priority mind in previous frames - at
+      // least one mind is updated so there is always progress and a new measurement
+      double fit_count = (m_low_mind_secs > 0.0) ? (end_time - start_time) / m_low_mind_secs : 1.0;
+      updated_count = uint32_t(FMath::Clamp(fit_count, 1.0, double(m_held_minds.Num())));
+
+      // Keep minds that already had their update this frame from running again
+      for (SkMind * mind_p : SkMind::get_updating_minds())
+        {
+        if (mind_p->is_updatable())
+          {
+          m_other_minds.Add(mind_p);
+          }
+        }
+      for (SkMind * mind_p : m_other_minds)
+        {
+        mind_p->enable_updatable(false);
+        }
+
+      // SkMind::update_all() only updates minds flagged as updatable - see SkMind::Flag_updatable
+      for (uint32_t idx = 0u; idx < updated_count; idx++)
+        {
+        SkMind * mind_p = m_held_minds[idx];
+
+        mind_p->enable_updatable(true);
+        m_update_frames.FindChecked(mind_p).m_updated_frame = m_frame;
+        }
+
+      update_minds();
+
+      double mind_secs = (FPlatformTime::Seconds() - start_time) / updated_count;
+      m_low_mind_secs = (m_low_mind_secs > 0.0) ? (m_low_mind_secs + mind_secs) * 0.5 : mind_secs;
+
+      for (SkMind * mind_p : m_other_minds)
+        {
+        mind_p->enable_updatable(true);
+        }
+      m_other_minds.Reset();
+      }
+
+    // Tally minds that have to wait for a later frame
+    for (uint32_t idx = updated_count; idx < uint32_t(m_held_minds.Num()); idx++)
+      {
+      SkMind *     mind_p = m_held_minds[idx];
+      MindFrames & frames = m_update_frames.FindChecked(mind_p);
+
+      if (!frames.m_updated_frame)
+        {
+        // Start counting from the first frame it was deferred
+        frames.m_updated_frame = m_frame - 1u;
+        }
+
+      m_deferred_minds++;
+      m_deferred_coroutines += mind_p->get_invoked_coroutines().get_count();
+      m_deferred_frames_max  = FMath::Max(m_deferred_frames_max, m_frame - frames.m_updated_frame);
+      }
+
+    for (SkMind * mind_p : m_held_minds)
+      {
+      mind_p->enable_updatable(true);
+      }
+    m_held_minds.Reset();
+
+    // Forget minds that are no longer low priority or active - i.e. not held this frame
+    for (auto iter = m_update_frames.CreateIterator(); iter; ++iter)
+      {
+      if (iter.Value().m_held_frame != m_frame)
+        {
+        iter.Key()->dereference();
+        iter.RemoveCurrent();
+        }
+      }
+    }
+
+  // Keep the minds already updated from running again in a later phase
+  if (is_phase_pending())
+    {
+    hold_phase_minds(Phase_dispatch, true);
+    }
+
+  SET_DWORD_STAT(STAT_SkookumScriptDeferredMinds, m_deferred_minds);
+  SET_DWORD_STAT(STAT_SkookumScriptDeferredCoroutines, m_deferred_coroutines);
+  SET_DWORD_STAT(STAT_SkookumScriptDeferredFramesMax, m_deferred_frames_max);
+  }
+
+//---------------------------------------------------------------------------------------
+// Lets go of all minds held on to - must be called before SkookumScript is reset
+void SkUEScheduler::release_minds()
+  {
+  release_phase_minds();
+  forget_update_frames();
+  }
+
+//---------------------------------------------------------------------------------------
+// Updates the minds assigned to a later phase of the world tick - call once per frame in
+// each phase after update()
+void SkUEScheduler::update_phase(ePhase phase)
+  {
+  SK_ASSERTX(phase != Phase_dispatch, "Phase_dispatch is updated by update() - its list holds the minds already updated this frame.");
+
+  TArray<SkMind *> & minds = m_phase_minds[phase];
+
+  if (minds.Num() == 0)
+    {
+    return;
+    }
+
+  for (SkMind * mind_p : minds)
+    {
+    mind_p->enable_updatable(true);
+    }
+
+  update_minds();
+
+  for (SkMind * mind_p : minds)
+    {
+    mind_p->enable_updatable(false);
+    }
+
+  // Hand minds that became active during the update on to a phase still to come
+  hold_phase_minds(phase, true);
+  }
+
+//---------------------------------------------------------------------------------------
+// Lets all minds held back by hold_phase_minds() be updated again - called at the start
+// of each frame and must be called before SkookumScript is reset
+void SkUEScheduler::release_phase_minds()
+  {
+  for (TArray<SkMind *> & minds : m_phase_minds)
+    {
+    for (SkMind * mind_p : minds)
+      {
+      mind_p->enable_updatable(true);
+      mind_p->dereference();
+      }
+    minds.Reset();
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Stops tracking when low priority minds were last updated and lets go of them
+void SkUEScheduler::forget_update_frames()
+  {
+  for (auto & pair : m_update_frames)
+    {
+    pair.Key->dereference();
+    }
+  m_update_frames.Reset();
+  }
+
+//---------------------------------------------------------------------------------------
+// Holds back all updatable minds until release_phase_minds() - each mind of a phase after
+// done_phase in the list of its phase and the others in the Phase_dispatch list
+//
+// #Params:
+//   done_phase: last phase updated so far this frame
+//   hold_done_b: whether to also hold back the minds of done_phase and earlier phases
+void SkUEScheduler::hold_phase_minds(ePhase done_phase, bool hold_done_b)
+  {
+  int32 first_idxs[Phase__count];
+  for (uint32_t phase = 0u; phase < Phase__count; phase++)
+    {
+    first_idxs[phase] = m_phase_minds[phase].Num();
+    }
+
+  for (SkMind * mind_p : SkMind::get_updating_minds())
+    {
+    if (mind_p->is_updatable())
+      {
+      ePhase phase = get_phase(mind_p);
+
+      if (phase > done_phase)
+        {
+        m_phase_minds[phase].Add(mind_p);
+        }
+      else if (hold_done_b)
+        {
+        m_phase_minds[Phase_dispatch].Add(mind_p);
+        }
+      }
+    }
+
+  // Disable after the pass over the minds so the list being iterated is left alone
+  for (uint32_t phase = 0u; phase < Phase__count; phase++)
+    {
+    TArray<SkMind *> & minds = m_phase_minds[phase];
+
+    for (int32 idx = first_idxs[phase]; idx < minds.Num(); idx++)
+      {
+      minds[idx]->reference();
+      minds[idx]->enable_updatable(false);
+      }
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Determines whether any minds are waiting for a later phase of the world tick
+bool SkUEScheduler::is_phase_pending() const
+  {
+  for (uint32_t phase = Phase_dispatch + 1u; phase < Phase__count; phase++)
+    {
+    if (m_phase_minds[phase].Num())
+      {
+      return true;
+      }
+    }
+
+  return false;
+  }
+
+//---------------------------------------------------------------------------------------
+// Advances sim time and updates all updatable minds - see SkRuntimeBase::update()
+void SkUEScheduler::update_sim(float sim_delta)
+  {
+  #ifdef SKOOKUM_PROFILER_UNREAL
+    if (SkUEProfiler::is_running())
+      {
+      // Advance sim time with all minds held back and then time each of them
+      hold_updatable_minds();
+      SkRuntimeBase::update(sim_delta);
+      update_minds_profiled();
+      return;
+      }
+  #endif
+
+  SkRuntimeBase::update(sim_delta);
+  }
+
+//---------------------------------------------------------------------------------------
+// Updates all updatable minds - see SkMind::update_all()
+void SkUEScheduler::update_minds()
+  {
+  #ifdef SKOOKUM_PROFILER_UNREAL
+    if (SkUEProfiler::is_running())
+      {
+      hold_updatable_minds();
+      update_minds_profiled();
+      return;
+      }
+  #endif
+
+  SkMind::update_all();
+  }
+
+#ifdef SKOOKUM_PROFILER_UNREAL
+
+//---------------------------------------------------------------------------------------
+// Appends all updatable minds to m_profiled_minds and keeps them from being updated
+void SkUEScheduler::hold_updatable_minds()
+  {
+  int32 first_idx = m_profiled_minds.Num();
+
+  for (SkMind * mind_p : SkMind::get_updating_minds())
+    {
+    if (mind_p->is_updatable())
+      {
+      m_profiled_minds.Add(mind_p);
+      }
+    }
+
+  for (int32 idx = first_idx; idx < m_profiled_minds.Num(); idx++)
+    {
+    SkMind * mind_p = m_profiled_minds[idx];
+
+    mind_p->reference();
+    mind_p->enable_updatable(false);
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Updates the minds held by hold_updatable_minds() in a single pass, each measured as
+// `MindClass@update` by SkUEProfiler
+void SkUEScheduler::update_minds_profiled()
+  {
+  int32 idx = 0;
+
+  while (idx < m_profiled_minds.Num())
+    {
+    for (; idx < m_profiled_minds.Num(); idx++)
+      {
+      SkMind * mind_p = m_profiled_minds[idx];
+
+      // Skip minds whose coroutines were all stopped by an earlier mind
+      if (mind_p->is_on_update_list())
+        {
+        mind_p->enable_updatable(true);
+
+          {
+          SKUE_PROFILE_SCOPE(mind_p->get_class()->get_name(), SkUEProfiler::get_symbol_update());
+          SkUEScheduler_Impl::MindUpdater::update(mind_p);
+          }
+
+        mind_p->enable_updatable(false);
+        }
+      }
+
+    // Minds that became active during the pass get a pass of their own - the minds
+    // already updated are still held back so they are not picked up again
+    hold_updatable_minds();
+    }
+
+  for (SkMind * mind_p : m_profiled_minds)
+    {
+    mind_p->enable_updatable(true);
+    mind_p->dereference();
+    }
+  m_profiled_minds.Reset();
+  }
+
+#endif  // SKOOKUM_PROFILER_UNREAL
+
+//---------------------------------------------------------------------------------------
+// Sets the phase of the world tick in which the coroutines of a mind are updated
+void SkUEScheduler::set_phase(SkMind * mind_p, ePhase phase)
+  {
+  mind_p->clear_mind_flags(MindFlag__phase_mask);
+  mind_p->set_mind_flags(uint32_t(phase) << MindFlag__phase_shift);
+  }
+
+//---------------------------------------------------------------------------------------
+// Gets the phase of the world tick in which the coroutines of a mind are updated
+SkUEScheduler::ePhase SkUEScheduler::get_phase(const SkMind * mind_p)
+  {
+  return ePhase((mind_p->get_mind_flags() & MindFlag__phase_mask) >> MindFlag__phase_shift);
+  }
+
+//---------------------------------------------------------------------------------------
+// Sets whether a mind may be skipped when the frame budget is spent
+void SkUEScheduler::set_low_priority(SkMind * mind_p, bool low_priority_b)
+  {
+  if (low_priority_b)
+    {
+    mind_p->set_mind_flags(MindFlag_low_priority);
+    }
+  else
+    {
+    mind_p->clear_mind_flags(MindFlag_low_priority);
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+
+void SkUEScheduler::register_bindings()
+  {
+  SkBrain::ms_mind_class_p->register_method_func_bulk(SkUEScheduler_Impl::methods_i, A_COUNT_OF(SkUEScheduler_Impl::methods_i), SkBindFlag_instance_no_rebind);
+  }
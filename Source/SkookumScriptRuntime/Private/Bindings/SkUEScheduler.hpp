@@ -0,0 +1,162 @@
+//=======================================================================================
+// SkookumScript Plugin for Unreal Engine 4
+// Copyright (c) 2015 Agog Labs Inc. All rights reserved.
+//
+// Frame time budget for the script update with priority based load shedding and
+// updates in several tick group phases
+//=======================================================================================
+
+#pragma once
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include "SkUEProfiler.hpp"
+
+#include <SkookumScript/SkMind.hpp>
+
+
+//=======================================================================================
+// Global Structures
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+// Runs the per-frame SkookumScript update within a time budget set with the
+// `sk.FrameBudgetMs` console variable (e.g. in the [SystemSettings] section of an ini
+// file) - 0 (default) updates everything every frame as before.
+//
+// Minds are either high priority (default) or low priority - see set_low_priority() and
+// `Mind@low_priority_set()`.  A coroutine has the priority of its updater mind, so work
+// that may be shed (ambient AI, cosmetic behaviours) is best grouped by diverting its
+// coroutines to a low priority mind.
+//
+// High priority minds are always updated first.  Low priority minds are then updated in a
+// single pass - least recently updated first - as many as are expected to fit in the rest
+// of the budget going by their average cost in previous frames, and the rest wait for a
+// later frame.  Since their coroutines keep their update times, they catch up on sim time
+// when they do run - though a frame's sim delta only covers the last frame.  A mind is the
+// smallest unit of work and the cost is an estimate, so the budget can still be exceeded.
+//
+// Minds can also be assigned to a later phase of the world tick - see set_phase() and
+// `Mind@tick_phase_set()`.  By default all coroutines are updated at the start of the
+// world tick before any actors tick, so they see physics and movement results of the
+// previous frame.  The coroutines of a mind assigned to e.g. Phase_post_physics wait
+// for that phase instead and see the results of the current frame.  Sim time is only
+// advanced at the start of the frame.
+//
+// Phases work per mind: at the start of the frame the minds of later phases are put in
+// a list per phase and held back, and each phase only enables the minds of its own list.
+// While any later phase is pending, all other minds are held back as well until the next
+// frame - so each mind is toggled at most twice per frame however many phases there are
+// and frames without any later phase minds cost nothing extra.  Minds that become active
+// part way through a frame are updated in the next phase still to come.
+class SkUEScheduler
+  {
+  public:
+
+  // Constants
+
+    // Phases of the world tick in which coroutines can be updated
+    enum ePhase
+      {
+      Phase_dispatch,         // Start of world tick before any tick group - default
+      Phase_pre_physics,      // TG_PrePhysics
+      Phase_post_physics,     // TG_PostPhysics - after physics simulation
+      Phase_post_update_work, // TG_PostUpdateWork - after movement and animation
+
+      Phase__count
+      };
+
+    enum eMindFlag
+      {
+      // Mind may be skipped when the frame budget is spent
+      MindFlag_low_priority = 1 << (SkMind_flag_user_shift + 0),
+
+      // Bits storing the ePhase of a mind
+      MindFlag__phase_shift = SkMind_flag_user_shift + 1,
+      MindFlag__phase_mask  = 0x3 << MindFlag__phase_shift
+      };
+
+  // Common Methods
+
+    SkUEScheduler();
+
+  // Methods
+
+    void update(float sim_delta);
+    void update_phase(ePhase phase);
+    void release_phase_minds();
+    void release_minds();
+
+    uint32_t get_deferred_mind_count() const      { return m_deferred_minds; }
+    uint32_t get_deferred_coroutine_count() const { return m_deferred_coroutines; }
+    uint32_t get_deferred_frames_max() const      { return m_deferred_frames_max; }
+
+  // Class Methods
+
+    static void set_low_priority(SkMind * mind_p, bool low_priority_b = true);
+    static bool is_low_priority(const SkMind * mind_p) { return mind_p->is_mind_flags(MindFlag_low_priority); }
+    static void set_phase(SkMind * mind_p, ePhase phase);
+    static ePhase get_phase(const SkMind * mind_p);
+
+    static void register_bindings();
+
+  protected:
+
+  // Nested Structures
+
+    // When a low priority mind was last updated
+    struct MindFrames
+      {
+      uint32_t m_updated_frame; // Frame of its last update - 0 if not updated yet
+      uint32_t m_held_frame;    // Last frame it was held back - to forget inactive minds
+      };
+
+  // Internal Methods
+
+    void hold_phase_minds(ePhase done_phase, bool hold_done_b);
+    void forget_update_frames();
+    bool is_phase_pending() const;
+
+    void update_sim(float sim_delta);
+    void update_minds();
+
+    #ifdef SKOOKUM_PROFILER_UNREAL
+      void hold_updatable_minds();
+      void update_minds_profiled();
+    #endif
+
+  // Data Members
+
+    uint32_t m_frame;
+
+    // Low priority minds held back from the main update this frame
+    TArray<SkMind *> m_held_minds;
+
+    // Minds disabled while the low priority minds are updated
+    TArray<SkMind *> m_other_minds;
+
+    // Minds held back until the update of their phase - the Phase_dispatch list holds
+    // the minds whose update is done for the frame
+    TArray<SkMind *> m_phase_minds[Phase__count];
+
+    #ifdef SKOOKUM_PROFILER_UNREAL
+      // Minds updated one at a time while SkUEProfiler is running
+      TArray<SkMind *> m_profiled_minds;
+    #endif
+
+    // Frames of each low priority mind held back recently - each mind is referenced while
+    // in here so a mind that goes away is forgotten rather than left dangling
+    TMap<SkMind *, MindFrames> m_update_frames;
+
+    // Running average of the seconds it took to update a low priority mind - to estimate
+    // how many of them fit in the time left of a frame
+    double m_low_mind_secs;
+
+    // Statistics of last frame
+    uint32_t m_deferred_minds;
+    uint32_t m_deferred_coroutines;
+    uint32_t m_deferred_frames_max;
+
+  };  // SkUEScheduler
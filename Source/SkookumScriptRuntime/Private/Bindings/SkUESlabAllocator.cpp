@@ -0,0 +1,397 @@
+//=======================================================================================
+// SkookumScript Plugin for Unreal Engine 4
+// Copyright (c) 2015 Agog Labs Inc. All rights reserved.
+//
+// Size-class slab allocator for small AgogCore/SkookumScript allocations
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include "SkUESlabAllocator.hpp"
+
+#include "HAL/UnrealMemory.h"
+#include "Misc/ScopeLock.h"
+
+
+//=======================================================================================
+// Class Data
+//=======================================================================================
+
+// Fine grained for the most common sizes, coarser above 128 bytes
+const uint32_t SkUESlabAllocator::ms_class_sizes[Size_class_count] =
+  {
+  16u, 32u, 48u, 64u, 80u, 96u, 112u, 128u, 160u, 192u, 224u, 256u
+  };
+
+// Size class of a request indexed by its size in units of Alignment (rounded up)
+const uint8 SkUESlabAllocator::ms_class_idx_by_size16[Size_max / Alignment + 1] =
+  {
+  0u, 0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 8u, 9u, 9u, 10u, 10u, 11u, 11u
+  };
+
+
+//=======================================================================================
+// Method Definitions
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+
+SkUESlabAllocator::SkUESlabAllocator()
+  : m_page_count(0)
+  {
+  for (uint32_t class_idx = 0u; class_idx < Size_class_count; ++class_idx)
+    {
+    SizeClass & size_class = m_classes[class_idx];
+
+    size_class.m_free_p        = nullptr;
+    size_class.m_bump_p        = nullptr;
+    size_class.m_bump_end_p    = nullptr;
+    size_class.m_page_count    = 0u;
+    size_class.m_alloc_count   = 0u;
+    size_class.m_release_count = 0u;
+    }
+
+  FMemory::Memzero(m_thread_caches, sizeof(m_thread_caches));
+  FMemory::Memzero((void *)m_page_table, sizeof(m_page_table));
+
+  m_thread_exit_func.m_func_p = &on_thread_exit;
+  m_thread_exit_func.m_user_p = this;
+  AgogCore::register_thread_exit_func(&m_thread_exit_func);
+  }
+
+//---------------------------------------------------------------------------------------
+// Notes:      Pages are only released if none of their slots are in use anymore - some
+//             static AgogCore objects may still be freed after the app info goes away
+//             and must not touch released memory.
+SkUESlabAllocator::~SkUESlabAllocator()
+  {
+  AgogCore::unregister_thread_exit_func(&m_thread_exit_func);
+
+  for (uint32_t class_idx = 0u; class_idx < Size_class_count; ++class_idx)
+    {
+    if (get_class_used_count(class_idx))
+      {
+      return;
+      }
+    }
+
+  for (uint32_t entry_idx = 0u; entry_idx < Page_table_size; ++entry_idx)
+    {
+    uintptr_t entry = m_page_table[entry_idx];
+    if (entry)
+      {
+      FMemory::Free(reinterpret_cast<void *>(entry & ~uintptr_t(Page_byte_size - 1)));
+      }
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Allocates memory - from the slabs if small enough
+// Returns:    16 byte aligned memory of at least size bytes
+void * SkUESlabAllocator::malloc(size_t size)
+  {
+  if (size > Size_max)
+    {
+    return FMemory::Malloc(size, Alignment);
+    }
+
+  uint32_t class_idx = get_class_idx(uint32_t(size));
+  uint32_t slot      = AgogCore::get_thread_slot();
+
+  if (slot >= Thread_slots)
+    {
+    // No free lists of its own for this thread
+    return malloc_central(class_idx);
+    }
+
+  CachedClass & cache = m_thread_caches[slot].m_classes[class_idx];
+  if (!cache.m_free_p && !refill(&cache, class_idx))
+    {
+    // Out of pages
+    return FMemory::Malloc(ms_class_sizes[class_idx], Alignment);
+    }
+
+  FreeSlot * slot_p = cache.m_free_p;
+  cache.m_free_p = slot_p->m_next_p;
+  cache.m_free_count--;
+  cache.m_alloc_count++;
+
+  return slot_p;
+  }
+
+//---------------------------------------------------------------------------------------
+// Frees memory previously allocated with malloc()
+void SkUESlabAllocator::free(void * mem_p)
+  {
+  int32 class_idx = find_page_class(reinterpret_cast<uintptr_t>(mem_p));
+  if (class_idx < 0)
+    {
+    // Not from a slab
+    FMemory::Free(mem_p);
+    return;
+    }
+
+  FreeSlot * slot_p = static_cast<FreeSlot *>(mem_p);
+  uint32_t   slot   = AgogCore::get_thread_slot();
+
+  if (slot >= Thread_slots)
+    {
+    // No free lists of its own for this thread - or it is exiting and gave them back
+    free_central(slot_p, class_idx);
+    return;
+    }
+
+  CachedClass & cache = m_thread_caches[slot].m_classes[class_idx];
+  slot_p->m_next_p = cache.m_free_p;
+  cache.m_free_p = slot_p;
+  cache.m_free_count++;
+  cache.m_release_count++;
+
+  // Keep a batch for upcoming requests and hand the rest back
+  if (cache.m_free_count >= 2u * Batch_count)
+    {
+    release_batch(&cache, class_idx, Batch_count);
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Converts needed byte size to the byte size that will actually be allocated
+uint32_t SkUESlabAllocator::request_byte_size(uint32_t size_requested)
+  {
+  return (size_requested && size_requested <= Size_max)
+    ? ms_class_sizes[get_class_idx(size_requested)]
+    : a_align_up(size_requested, Alignment);
+  }
+
+//---------------------------------------------------------------------------------------
+// Number of slots of a size class currently allocated
+uint32_t SkUESlabAllocator::get_class_used_count(uint32_t class_idx) const
+  {
+  const SizeClass & size_class = m_classes[class_idx];
+  uint32_t          used_count = size_class.m_alloc_count - size_class.m_release_count;
+
+  // Slots may be freed by a different thread than the one that allocated them so only
+  // the sum over all threads is meaningful
+  for (uint32_t slot = 0u; slot < Thread_slots; ++slot)
+    {
+    const CachedClass & cache = m_thread_caches[slot].m_classes[class_idx];
+    used_count += cache.m_alloc_count - cache.m_release_count;
+    }
+
+  return used_count;
+  }
+
+//---------------------------------------------------------------------------------------
+// Number of calls to malloc() ever made for a size class
+uint32_t SkUESlabAllocator::get_class_alloc_count(uint32_t class_idx) const
+  {
+  uint32_t alloc_count = m_classes[class_idx].m_alloc_count;
+
+  for (uint32_t slot = 0u; slot < Thread_slots; ++slot)
+    {
+    alloc_count += m_thread_caches[slot].m_classes[class_idx].m_alloc_count;
+    }
+
+  return alloc_count;
+  }
+
+//---------------------------------------------------------------------------------------
+// Allocates a single slot from the central free list - for threads without a slot
+void * SkUESlabAllocator::malloc_central(uint32_t class_idx)
+  {
+  SizeClass & size_class = m_classes[class_idx];
+  FScopeLock  lock(&size_class.m_lock);
+  uint32_t    taken_count;
+  FreeSlot *  slot_p = take_slots(class_idx, 1u, &taken_count);
+
+  if (!slot_p)
+    {
+    // Out of pages
+    return FMemory::Malloc(ms_class_sizes[class_idx], Alignment);
+    }
+
+  size_class.m_alloc_count++;
+
+  return slot_p;
+  }
+
+//---------------------------------------------------------------------------------------
+// Frees a single slot to the central free list - for threads without a slot
+void SkUESlabAllocator::free_central(FreeSlot * slot_p, uint32_t class_idx)
+  {
+  SizeClass & size_class = m_classes[class_idx];
+  FScopeLock  lock(&size_class.m_lock);
+
+  slot_p->m_next_p = size_class.m_free_p;
+  size_class.m_free_p = slot_p;
+  size_class.m_release_count++;
+  }
+
+//---------------------------------------------------------------------------------------
+// Gets a batch of slots from the central free list into an empty thread free list
+// Returns:    false if out of pages
+bool SkUESlabAllocator::refill(CachedClass * cache_p, uint32_t class_idx)
+  {
+  FScopeLock lock(&m_classes[class_idx].m_lock);
+
+  cache_p->m_free_p = take_slots(class_idx, Batch_count, &cache_p->m_free_count);
+
+  return cache_p->m_free_p != nullptr;
+  }
+
+//---------------------------------------------------------------------------------------
+// Hands count slots of a thread free list back to the central free list
+void SkUESlabAllocator::release_batch(CachedClass * cache_p, uint32_t class_idx, uint32_t count)
+  {
+  if (!count)
+    {
+    return;
+    }
+
+  // Unlink the first count slots - without lock since the thread list is ours
+  FreeSlot * first_p = cache_p->m_free_p;
+  FreeSlot * last_p  = first_p;
+  for (uint32_t idx = 1u; idx < count; ++idx)
+    {
+    last_p = last_p->m_next_p;
+    }
+  cache_p->m_free_p = last_p->m_next_p;
+  cache_p->m_free_count -= count;
+
+  SizeClass & size_class = m_classes[class_idx];
+  FScopeLock  lock(&size_class.m_lock);
+
+  last_p->m_next_p = size_class.m_free_p;
+  size_class.m_free_p = first_p;
+  }
+
+//---------------------------------------------------------------------------------------
+// Unlinks up to count slots from the central free list - carving new ones from the
+// current page if needed
+// Returns:    list of slots or nullptr if out of pages
+// Notes:      the size class lock must be held
+SkUESlabAllocator::FreeSlot * SkUESlabAllocator::take_slots(uint32_t class_idx, uint32_t count, uint32_t * taken_count_p)
+  {
+  SizeClass & size_class = m_classes[class_idx];
+  uint32_t    slot_size  = ms_class_sizes[class_idx];
+  FreeSlot *  first_p    = nullptr;
+  uint32_t    taken      = 0u;
+
+  // Reuse recycled slots
+  while (taken < count && size_class.m_free_p)
+    {
+    FreeSlot * slot_p = size_class.m_free_p;
+    size_class.m_free_p = slot_p->m_next_p;
+    slot_p->m_next_p = first_p;
+    first_p = slot_p;
+    taken++;
+    }
+
+  // Carve new slots from current page
+  while (taken < count)
+    {
+    if (size_class.m_bump_p == size_class.m_bump_end_p && !add_page(class_idx))
+      {
+      break;
+      }
+
+    FreeSlot * slot_p = reinterpret_cast<FreeSlot *>(size_class.m_bump_p);
+    size_class.m_bump_p += slot_size;
+    slot_p->m_next_p = first_p;
+    first_p = slot_p;
+    taken++;
+    }
+
+  *taken_count_p = taken;
+
+  return first_p;
+  }
+
+//---------------------------------------------------------------------------------------
+// Gets a fresh page for the given size class
+// Returns:    false if out of memory or if the page table is full
+// Notes:      the size class lock must be held
+bool SkUESlabAllocator::add_page(uint32_t class_idx)
+  {
+  if (FPlatformAtomics::InterlockedIncrement(&m_page_count) > Page_count_max)
+    {
+    FPlatformAtomics::InterlockedDecrement(&m_page_count);
+    return false;
+    }
+
+  uint8 * page_p = static_cast<uint8 *>(FMemory::Malloc(Page_byte_size, Page_byte_size));
+  if (!page_p)
+    {
+    FPlatformAtomics::InterlockedDecrement(&m_page_count);
+    return false;
+    }
+
+  // Register page - other size classes may be adding pages at the same time
+  uintptr_t address = reinterpret_cast<uintptr_t>(page_p);
+  uintptr_t entry   = address | (class_idx + 1u);
+  for (uint32_t entry_idx = get_page_hash(address); ; ++entry_idx)
+    {
+    volatile uintptr_t * entry_p = &m_page_table[entry_idx & (Page_table_size - 1u)];
+    if (!*entry_p && FPlatformAtomics::InterlockedCompareExchangePointer((void **)entry_p, (void *)entry, nullptr) == nullptr)
+      {
+      break;
+      }
+    }
+
+  // Any slack at the end of the page smaller than a slot is left unused
+  SizeClass & size_class = m_classes[class_idx];
+  uint32_t    slot_size  = ms_class_sizes[class_idx];
+  size_class.m_bump_p     = page_p;
+  size_class.m_bump_end_p = page_p + (Page_byte_size / slot_size) * slot_size;
+  size_class.m_page_count++;
+
+  return true;
+  }
+
+//---------------------------------------------------------------------------------------
+// Looks up the size class of the page containing address - without locking
+// Returns:    size class index or -1 if address is not part of any page
+int32 SkUESlabAllocator::find_page_class(uintptr_t address) const
+  {
+  uintptr_t page_address = address & ~uintptr_t(Page_byte_size - 1);
+
+  // Pages are only ever added and the table is never full, so an empty entry ends the search
+  for (uint32_t entry_idx = get_page_hash(page_address); ; ++entry_idx)
+    {
+    uintptr_t entry = m_page_table[entry_idx & (Page_table_size - 1u)];
+    if (!entry)
+      {
+      return -1;
+      }
+
+    if ((entry & ~uintptr_t(Page_byte_size - 1)) == page_address)
+      {
+      return int32(entry & uintptr_t(Page_byte_size - 1)) - 1;
+      }
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Hands all slots of the free lists of a thread slot back to the central free lists
+void SkUESlabAllocator::flush_thread_slot(uint32_t slot)
+  {
+  if (slot < Thread_slots)
+    {
+    for (uint32_t class_idx = 0u; class_idx < Size_class_count; ++class_idx)
+      {
+      CachedClass & cache = m_thread_caches[slot].m_classes[class_idx];
+      release_batch(&cache, class_idx, cache.m_free_count);
+      }
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Called on a thread right before it exits - so its free slots are not stranded in
+// a thread slot that might not be used again for a long time
+void SkUESlabAllocator::on_thread_exit(void * user_p, uint32_t thread_slot)
+  {
+  static_cast<SkUESlabAllocator *>(user_p)->flush_thread_slot(thread_slot);
+  }
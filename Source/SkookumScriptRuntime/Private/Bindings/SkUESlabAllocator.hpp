@@ -0,0 +1,158 @@
+//=======================================================================================
+// SkookumScript Plugin for Unreal Engine 4
+// Copyright (c) 2015 Agog Labs Inc. All rights reserved.
+//
+// Size-class slab allocator for small AgogCore/SkookumScript allocations
+//=======================================================================================
+
+#pragma once
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include <AgogCore/AgogCore.hpp>
+
+#include "HAL/ThreadingBase.h"
+
+
+//=======================================================================================
+// Global Structures
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+// Serves small allocations (<= Size_max bytes) from 64KB pages split into fixed size
+// slots of a handful of size classes - each with its own free lists. Larger allocations
+// go straight to FMemory.
+//
+// Most of the heap traffic of AgogCore/SkookumScript (AString buffers, APArray growth,
+// SK_NEW_OPERATORS objects) is small and short-lived so this keeps it out of the
+// general purpose allocator. Since the size of a request is rounded up to its size class,
+// request_byte_size() lets containers make use of the slack.
+//
+// Pages are never returned to the system while the allocator is alive.
+//
+// Thread safe:
+//   - Each thread with a slot (see AgogCore::get_thread_slot()) allocates from and frees
+//     to its own free list per size class without any locking. Only when its list runs
+//     empty or grows too long does it trade a batch of slots with the central free list
+//     of that size class, which has its own lock.
+//   - Pages are aligned to their size and registered in a lock-free table, so free() can
+//     tell slab memory from large allocations without locking.
+//   - When a thread exits, its free lists are handed back to the central ones. Memory
+//     freed by thread_local destructors running after that goes through the locked
+//     central free lists since the slot may already belong to another thread.
+//   - The statistics accessors do not lock and are only approximate while other threads
+//     allocate.
+class SkUESlabAllocator
+  {
+  public:
+
+  // Constants
+
+    enum
+      {
+      Size_max           = 256,        // Largest request served by the slabs
+      Size_class_count   = 12,         // Number of size classes - see ms_class_sizes
+      Page_byte_size     = 64 * 1024,  // Byte size and alignment of pages the slabs are carved from
+      Page_count_max     = 12 * 1024,  // Once this many pages exist, small requests also go to FMemory
+      Page_table_size    = 16 * 1024,  // Slots of the page table - must be a power of 2 above Page_count_max
+      Alignment          = 16,         // All slots and large allocations are aligned to this
+      Thread_slots       = 32,         // Threads with their own free lists - others lock for each request
+      Batch_count        = 32          // Slots traded between a thread and the central free list at once
+      };
+
+  // Common Methods
+
+    SkUESlabAllocator();
+    ~SkUESlabAllocator();
+
+  // Methods
+
+    void *   malloc(size_t size);
+    void     free(void * mem_p);
+
+    static uint32_t request_byte_size(uint32_t size_requested);
+
+  // Statistics
+
+    static uint32_t get_class_byte_size(uint32_t class_idx) { return ms_class_sizes[class_idx]; }
+    uint32_t        get_class_used_count(uint32_t class_idx) const;
+    uint32_t        get_class_page_count(uint32_t class_idx) const  { return m_classes[class_idx].m_page_count; }
+    uint32_t        get_class_alloc_count(uint32_t class_idx) const;
+    uint32_t        get_page_count() const                          { return uint32_t(m_page_count); }
+
+  protected:
+
+  // Internal Types
+
+    // Slot of a size class not currently in use
+    struct FreeSlot
+      {
+      FreeSlot * m_next_p;
+      };
+
+    // Free list of a size class owned by a single thread
+    struct CachedClass
+      {
+      FreeSlot * m_free_p;
+      uint32_t   m_free_count;
+      uint32_t   m_alloc_count;   // Number of malloc() calls served by this thread slot
+      uint32_t   m_release_count; // Number of free() calls served by this thread slot
+      };
+
+    // Free lists of a single thread
+    // Cache line aligned so threads do not contend over neighboring entries
+    struct alignas(64) ThreadCache
+      {
+      CachedClass m_classes[Size_class_count];
+      };
+
+    // Central bookkeeping of a single size class - protected by m_lock
+    struct SizeClass
+      {
+      FCriticalSection m_lock;
+      FreeSlot *       m_free_p;        // Recycled slots
+      uint8 *          m_bump_p;        // Never used slots of the newest page start here...
+      uint8 *          m_bump_end_p;    // ...and end here
+      uint32_t         m_page_count;
+      uint32_t         m_alloc_count;   // Number of malloc() calls of threads without a slot
+      uint32_t         m_release_count; // Number of free() calls of threads without a slot
+      };
+
+  // Internal Methods
+
+    static uint32_t get_class_idx(uint32_t size) { return ms_class_idx_by_size16[(size + (Alignment - 1u)) / Alignment]; }
+    static uint32_t get_page_hash(uintptr_t page_address) { return uint32_t(page_address / Page_byte_size) * 2654435761u; } // Scatters neighboring pages
+
+    void *          malloc_central(uint32_t class_idx);
+    void            free_central(FreeSlot * slot_p, uint32_t class_idx);
+    bool            refill(CachedClass * cache_p, uint32_t class_idx);
+    void            release_batch(CachedClass * cache_p, uint32_t class_idx, uint32_t count);
+    FreeSlot *      take_slots(uint32_t class_idx, uint32_t count, uint32_t * taken_count_p);
+    bool            add_page(uint32_t class_idx);
+    int32           find_page_class(uintptr_t address) const;
+    void            flush_thread_slot(uint32_t slot);
+    static void     on_thread_exit(void * user_p, uint32_t thread_slot);
+
+  // Data Members
+
+    SizeClass m_classes[Size_class_count];
+
+    // Free lists of each thread indexed by AgogCore::get_thread_slot()
+    ThreadCache m_thread_caches[Thread_slots];
+
+    // Address of each page with its size class index + 1 in the low bits - open addressing
+    // by page address. Entries are only ever added so it can be read without locking.
+    volatile uintptr_t m_page_table[Page_table_size];
+    volatile int32     m_page_count;
+
+    // Hands free lists of exiting threads back
+    AgogCore::AThreadExitFunc m_thread_exit_func;
+
+  // Class Data Members
+
+    static const uint32_t ms_class_sizes[Size_class_count];
+    static const uint8    ms_class_idx_by_size16[Size_max / Alignment + 1];
+
+  };  // SkUESlabAllocator
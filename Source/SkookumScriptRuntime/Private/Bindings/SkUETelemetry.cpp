@@ -0,0 +1,236 @@
+//=======================================================================================
+// SkookumScript Plugin for Unreal Engine 4
+// Copyright (c) 2015 Agog Labs Inc. All rights reserved.
+//
+// Live pool and memory telemetry exported as UE stats and optional CSV stream
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include "SkUETelemetry.hpp"
+
+#ifdef SKOOKUM_TELEMETRY_UNREAL
+
+#include "SkUESlabAllocator.hpp"
+#include "../SkookumScriptListenerManager.hpp"
+#include "ISkookumScriptRuntime.h"
+
+#include "Stats.h"
+#include "HAL/FileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+#include <AgogCore/ADeferRelease.hpp>
+#include <AgogCore/AMemory.hpp>
+#include <AgogCore/AStringRef.hpp>
+#include <AgogCore/ASymbol.hpp>
+#include <SkookumScript/SkBrain.hpp>
+#include <SkookumScript/SkClass.hpp>
+#include <SkookumScript/SkDataInstance.hpp>
+#include <SkookumScript/SkInvokedCoroutine.hpp>
+
+
+//=======================================================================================
+// Stats
+//=======================================================================================
+
+DECLARE_STATS_GROUP(TEXT("SkookumScript Memory"), STATGROUP_SkookumScriptMemory, STATCAT_Advanced);
+
+#define SKUE_POOL(_name, _pool) \
+  DECLARE_DWORD_ACCUMULATOR_STAT(TEXT(#_name " Live"),     STAT_SkPool##_name##Live,     STATGROUP_SkookumScriptMemory); \
+  DECLARE_DWORD_ACCUMULATOR_STAT(TEXT(#_name " Peak"),     STAT_SkPool##_name##Peak,     STATGROUP_SkookumScriptMemory); \
+  DECLARE_DWORD_ACCUMULATOR_STAT(TEXT(#_name " Overflow"), STAT_SkPool##_name##Overflow, STATGROUP_SkookumScriptMemory); \
+  DECLARE_DWORD_ACCUMULATOR_STAT(TEXT(#_name " Free"),     STAT_SkPool##_name##Free,     STATGROUP_SkookumScriptMemory);
+  SKUE_TELEMETRY_POOLS
+#undef SKUE_POOL
+
+#define SKUE_TRIMMABLE_POOL(_name, _pool) \
+  DECLARE_DWORD_ACCUMULATOR_STAT(TEXT(#_name " Trimmed"),  STAT_SkPool##_name##Trimmed,  STATGROUP_SkookumScriptMemory);
+  SKUE_TELEMETRY_TRIMMABLE_POOLS
+#undef SKUE_TRIMMABLE_POOL
+
+DECLARE_MEMORY_STAT(TEXT("Slab Used"),               STAT_SkSlabUsed,     STATGROUP_SkookumScriptMemory);
+DECLARE_MEMORY_STAT(TEXT("Slab Reserved"),           STAT_SkSlabReserved, STATGROUP_SkookumScriptMemory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Slab Allocs"),      STAT_SkSlabAllocs,   STATGROUP_SkookumScriptMemory);
+DECLARE_MEMORY_STAT(TEXT("Script Code (sampled)"),   STAT_SkCodeBytes,    STATGROUP_SkookumScriptMemory);
+
+
+//=======================================================================================
+// Method Definitions
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+
+SkUETelemetry::SkUETelemetry() :
+  m_frame(0u),
+  m_start_secs(0.0),
+  m_next_type_sample_secs(0.0),
+  m_prev_slab_allocs(0u),
+  m_csv_p(nullptr)
+  {
+  }
+
+//---------------------------------------------------------------------------------------
+
+SkUETelemetry::~SkUETelemetry()
+  {
+  deinitialize();
+  }
+
+//---------------------------------------------------------------------------------------
+// Opens CSV stream if requested on the command line
+void SkUETelemetry::initialize()
+  {
+  m_frame      = 0u;
+  m_start_secs = FPlatformTime::Seconds();
+  m_next_type_sample_secs = m_start_secs;
+
+  FString csv_path;
+  if (!m_csv_p && FParse::Value(FCommandLine::Get(), TEXT("SkookumTelemetryCsv="), csv_path))
+    {
+    m_csv_p = IFileManager::Get().CreateFileWriter(*csv_path, FILEWRITE_AllowRead);
+    if (m_csv_p)
+      {
+      FTCHARToUTF8 header(TEXT("Frame,Seconds,Metric,Value\n"));
+      m_csv_p->Serialize((void *)header.Get(), header.Length());
+      }
+    else
+      {
+      UE_LOG(LogSkookum, Warning, TEXT("Could not open SkookumScript telemetry CSV file '%s'."), *csv_path);
+      }
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Closes CSV stream
+void SkUETelemetry::deinitialize()
+  {
+  if (m_csv_p)
+    {
+    m_csv_p->Close();
+    delete m_csv_p;
+    m_csv_p = nullptr;
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Samples and publishes all numbers - call once per frame
+void SkUETelemetry::update(const SkUESlabAllocator & allocator)
+  {
+  m_frame++;
+
+  // Object pools
+  #define SKUE_POOL(_name, _pool) \
+    { \
+    const auto & pool = _pool; \
+    SET_DWORD_STAT(STAT_SkPool##_name##Live,     pool.get_count_used()); \
+    SET_DWORD_STAT(STAT_SkPool##_name##Peak,     pool.get_count_max()); \
+    SET_DWORD_STAT(STAT_SkPool##_name##Overflow, pool.get_count_overflow()); \
+    SET_DWORD_STAT(STAT_SkPool##_name##Free,     pool.get_count_available()); \
+    if (m_csv_p) \
+      { \
+      write_csv_row(TEXT(#_name " Live"),     pool.get_count_used()); \
+      write_csv_row(TEXT(#_name " Peak"),     pool.get_count_max()); \
+      write_csv_row(TEXT(#_name " Overflow"), pool.get_count_overflow()); \
+      write_csv_row(TEXT(#_name " Free"),     pool.get_count_available()); \
+      } \
+    }
+    SKUE_TELEMETRY_POOLS
+  #undef SKUE_POOL
+
+  #define SKUE_TRIMMABLE_POOL(_name, _pool) \
+    { \
+    const auto & pool = _pool; \
+    SET_DWORD_STAT(STAT_SkPool##_name##Trimmed, pool.get_count_trimmed()); \
+    if (m_csv_p) \
+      { \
+      write_csv_row(TEXT(#_name " Trimmed"), pool.get_count_trimmed()); \
+      } \
+    }
+    SKUE_TELEMETRY_TRIMMABLE_POOLS
+  #undef SKUE_TRIMMABLE_POOL
+
+  // Slab allocator
+  uint32_t slab_used   = 0u;
+  uint32_t slab_allocs = 0u;
+  for (uint32_t class_idx = 0u; class_idx < SkUESlabAllocator::Size_class_count; ++class_idx)
+    {
+    slab_used   += allocator.get_class_used_count(class_idx) * SkUESlabAllocator::get_class_byte_size(class_idx);
+    slab_allocs += allocator.get_class_alloc_count(class_idx);
+    }
+  uint32_t slab_reserved = allocator.get_page_count() * SkUESlabAllocator::Page_byte_size;
+  uint32_t slab_frame_allocs = slab_allocs - m_prev_slab_allocs;
+  m_prev_slab_allocs = slab_allocs;
+
+  SET_MEMORY_STAT(STAT_SkSlabUsed, slab_used);
+  SET_MEMORY_STAT(STAT_SkSlabReserved, slab_reserved);
+  SET_DWORD_STAT(STAT_SkSlabAllocs, slab_frame_allocs);
+
+  if (m_csv_p)
+    {
+    write_csv_row(TEXT("Slab Used"), slab_used);
+    write_csv_row(TEXT("Slab Reserved"), slab_reserved);
+    write_csv_row(TEXT("Slab Allocs"), slab_frame_allocs);
+    write_csv_row(TEXT("Release Queue"), ADeferRelease::get_length());
+    write_csv_row(TEXT("Release Queue Peak"), ADeferRelease::get_length_max());
+    }
+
+  // Walking all the script code is too slow to do every frame
+  if (FPlatformTime::Seconds() >= m_next_type_sample_secs)
+    {
+    m_next_type_sample_secs = FPlatformTime::Seconds() + Type_sample_interval_secs;
+    sample_memory_types();
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Appends a single value of the current frame to the CSV stream
+void SkUETelemetry::write_csv_row(const TCHAR * metric_p, uint32_t value)
+  {
+  FString      row = FString::Printf(TEXT("%u,%.3f,%s,%u\n"), m_frame, FPlatformTime::Seconds() - m_start_secs, metric_p, value);
+  FTCHARToUTF8 row_utf8(*row);
+  m_csv_p->Serialize((void *)row_utf8.Get(), row_utf8.Length());
+  }
+
+//---------------------------------------------------------------------------------------
+// Publishes bytes of all loaded script code - and bytes by AMemoryStats type to the CSV
+// stream if enabled
+void SkUETelemetry::sample_memory_types()
+  {
+  if (!SkBrain::ms_object_class_p)
+    {
+    return;
+    }
+
+  AMemoryStats mem_stats;
+  SkBrain::ms_object_class_p->track_memory_recursive(&mem_stats, true);
+  SkClass::shared_track_memory(&mem_stats);
+
+  const char * type_cstr_p;
+  uint32_t     alloc_count;
+  uint32_t     bytes;
+  uint32_t     total_bytes = 0u;
+  uint32_t     type_count  = mem_stats.get_type_count();
+
+  for (uint32_t idx = 0u; idx < type_count; ++idx)
+    {
+    mem_stats.get_type_info(idx, &type_cstr_p, &alloc_count, &bytes);
+    if (m_csv_p)
+      {
+      write_csv_row(*FString::Printf(TEXT("Code %s Bytes"), ANSI_TO_TCHAR(type_cstr_p)), bytes);
+      write_csv_row(*FString::Printf(TEXT("Code %s Count"), ANSI_TO_TCHAR(type_cstr_p)), alloc_count);
+      }
+    total_bytes += bytes;
+    }
+
+  SET_MEMORY_STAT(STAT_SkCodeBytes, total_bytes);
+  if (m_csv_p)
+    {
+    write_csv_row(TEXT("Code Bytes"), total_bytes);
+    }
+  }
+
+#endif  // SKOOKUM_TELEMETRY_UNREAL
@@ -0,0 +1,114 @@
+//=======================================================================================
+// SkookumScript Plugin for Unreal Engine 4
+// Copyright (c) 2015 Agog Labs Inc. All rights reserved.
+//
+// Live pool and memory telemetry exported as UE stats and optional CSV stream
+//=======================================================================================
+
+#pragma once
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include <AgogCore/AObjReusePool.hpp>
+
+class FArchive;
+class SkUESlabAllocator;
+
+
+//=======================================================================================
+// Global Macros / Defines
+//=======================================================================================
+
+// Pool usage counts only exist in Debug, Development and Test builds - and telemetry is
+// left out of lean dedicated servers
+#if defined(AORPOOL_USAGE_COUNT) && !defined(SK_LEAN_SERVER)
+  #define SKOOKUM_TELEMETRY_UNREAL
+#endif
+
+//---------------------------------------------------------------------------------------
+// Object pools to publish - SKUE_POOL(Name, PoolExpression)
+//
+// Add pools here - they automatically get stats and CSV columns.
+#define SKUE_TELEMETRY_POOLS \
+  SKUE_POOL(Instance,          SkInstance::get_pool()) \
+  SKUE_POOL(DataInstance,      SkDataInstance::get_pool()) \
+  SKUE_POOL(InvokedExpression, SkInvokedExpression::get_pool()) \
+  SKUE_POOL(InvokedCoroutine,  SkInvokedCoroutine::get_pool()) \
+  SKUE_POOL(StringRef,         AStringRef::get_pool()) \
+  SKUE_POOL(SymbolRef,         ASymbolRef::get_pool()) \
+  SKUE_POOL(ListenerEvent,     SkookumScriptListenerManager::get_singleton()->get_event_pool()) \
+
+//---------------------------------------------------------------------------------------
+// Pools of SKUE_TELEMETRY_POOLS that can give memory back (AObjReusePoolTrimmable) -
+// SKUE_TRIMMABLE_POOL(Name, PoolExpression)
+#define SKUE_TELEMETRY_TRIMMABLE_POOLS \
+  SKUE_TRIMMABLE_POOL(ListenerEvent, SkookumScriptListenerManager::get_singleton()->get_event_pool()) \
+
+
+#ifdef SKOOKUM_TELEMETRY_UNREAL
+
+//=======================================================================================
+// Global Structures
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+// Samples the SkookumScript object pools and the slab allocator once per frame and
+// publishes live/peak/overflow/free counts of the pools (plus objects given back by
+// trimmable pools) and bytes and allocations per frame of the slab allocator in the
+// "SkookumScript Memory" stat group (`stat SkookumScriptMemory`). Bytes of the loaded
+// script code are sampled every few seconds.
+//
+// Most pools are owned by the precompiled SkookumScript library, so only the counters the
+// library itself maintains (see AORPOOL_USAGE_COUNT) are read from them.
+//
+// When started with `-SkookumTelemetryCsv=<file>` the same numbers are also streamed to a
+// CSV file in long format (Frame,Seconds,Metric,Value) together with bytes by
+// AMemoryStats type of the loaded script code - to size
+// SkookumScript::pools_reserve() from real usage rather than guessing.
+class SkUETelemetry
+  {
+  public:
+
+  // Constants
+
+    enum
+      {
+      Type_sample_interval_secs = 5 // Seconds between samples of memory by type
+      };
+
+  // Common Methods
+
+    SkUETelemetry();
+    ~SkUETelemetry();
+
+  // Methods
+
+    void initialize();
+    void deinitialize();
+
+    void update(const SkUESlabAllocator & allocator);
+
+  protected:
+
+  // Internal Methods
+
+    void write_csv_row(const TCHAR * metric_p, uint32_t value);
+    void sample_memory_types();
+
+  // Data Members
+
+    uint32_t   m_frame;
+    double     m_start_secs;
+    double     m_next_type_sample_secs;
+
+    // Slab allocation count of last frame - to determine allocations per frame
+    uint32_t   m_prev_slab_allocs;
+
+    // CSV stream - nullptr if not enabled
+    FArchive * m_csv_p;
+
+  };  // SkUETelemetry
+
+#endif  // SKOOKUM_TELEMETRY_UNREAL
@@ -14,3 +14,227 @@
 
 #include "SkUEUtils.hpp"
 
+
+//=======================================================================================
+// Local Global Structures
+//=======================================================================================
+
+namespace
+{
+
+  //---------------------------------------------------------------------------------------
+  // Slot of the symbol -> FName table
+  struct SkUESymbolToNameSlot
+    {
+    volatile int32 m_sym_id;    // Key - ASymbol_id_null if slot is unused
+    volatile int32 m_ready;     // Set once m_name is valid
+    FName          m_name;
+    };
+
+  //---------------------------------------------------------------------------------------
+  // Slot of the FName -> symbol table
+  struct SkUENameToSymbolSlot
+    {
+    volatile int64 m_name_key;  // Key - see get_name_key() - 0 if slot is unused
+    volatile int32 m_ready;     // Set once m_symbol is valid
+    ASymbol        m_symbol;
+    };
+
+  SkUESymbolToNameSlot * g_sym_to_name_p = nullptr;
+  SkUENameToSymbolSlot * g_name_to_sym_p = nullptr;
+
+  //---------------------------------------------------------------------------------------
+  // Key of a name in the FName -> symbol table - display index rather than comparison
+  // index since symbols are case sensitive. Only `NAME_None` has a key of 0.
+  inline int64 get_name_key(const FName & name)
+    {
+    return int64((uint64(uint32(name.GetDisplayIndex())) << 32u) | uint32(name.GetNumber()));
+    }
+
+  //---------------------------------------------------------------------------------------
+  // Determines if the payload of a slot whose key matched has been published yet
+  inline bool is_slot_ready(volatile int32 & ready)
+    {
+    if (ready)
+      {
+      // Make sure the payload is not read before the ready flag
+      FPlatformMisc::MemoryBarrier();
+      return true;
+      }
+
+    return false;
+    }
+
+  //---------------------------------------------------------------------------------------
+  // Makes the payload of a slot claimed by the calling thread visible to other threads
+  inline void publish_slot(volatile int32 & ready)
+    {
+    FPlatformMisc::MemoryBarrier();
+    FPlatformAtomics::InterlockedExchange(&ready, 1);
+    }
+
+} // End unnamed namespace
+
+
+//=======================================================================================
+// SkUENameCache Class Methods
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+// Allocates the cache tables - must be called after AgogCore has been initialized
+void SkUENameCache::initialize()
+  {
+  A_ASSERTX(!g_sym_to_name_p, "SkUENameCache initialized twice in a row.");
+
+  g_sym_to_name_p = new SkUESymbolToNameSlot[Capacity];
+  g_name_to_sym_p = new SkUENameToSymbolSlot[Capacity];
+
+  for (uint32_t idx = 0u; idx < Capacity; ++idx)
+    {
+    g_sym_to_name_p[idx].m_sym_id   = int32(ASymbol_id_null);
+    g_sym_to_name_p[idx].m_ready    = 0;
+    g_name_to_sym_p[idx].m_name_key = 0;
+    g_name_to_sym_p[idx].m_ready    = 0;
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Frees the cache tables and releases all cached symbols
+// Must be called while no other thread uses them and before the symbol table goes away
+void SkUENameCache::deinitialize()
+  {
+  delete [] g_sym_to_name_p;
+  g_sym_to_name_p = nullptr;
+
+  delete [] g_name_to_sym_p;
+  g_name_to_sym_p = nullptr;
+  }
+
+//---------------------------------------------------------------------------------------
+// Converts `ASymbol` to `FName` - looking it up in the cache first.
+// 
+// Symbol ids are unique per string, so a hit is a single id compare. May be called from
+// any thread.
+// 
+// #Params
+//   sym: symbol to convert
+//   add_if_missing:
+//     if true the name is added to the `FName` system if not already present, if false
+//     `NAME_None` is returned for unknown names (like `FNAME_Find`)
+FName SkUENameCache::get_fname(const ASymbol & sym, bool add_if_missing)
+  {
+  uint32_t sym_id = sym.get_id();
+
+  if (sym_id == ASymbol_id_null)
+    {
+    return NAME_None;
+    }
+
+  if (!g_sym_to_name_p)
+    {
+    return FName(sym.as_cstr(), add_if_missing ? FNAME_Add : FNAME_Find);
+    }
+
+  // Look for existing entry or claim an empty slot
+  SkUESymbolToNameSlot * slot_p = nullptr;
+  uint32_t idx = sym_id;  // Ids are checksums so already well distributed
+  for (uint32_t probe = 0u; probe < Probe_max; ++probe, ++idx)
+    {
+    SkUESymbolToNameSlot & slot = g_sym_to_name_p[idx & (Capacity - 1u)];
+    int32 slot_id = slot.m_sym_id;
+
+    if (slot_id == int32(ASymbol_id_null))
+      {
+      slot_id = FPlatformAtomics::InterlockedCompareExchange(&slot.m_sym_id, int32(sym_id), int32(ASymbol_id_null));
+      if (slot_id == int32(ASymbol_id_null))
+        {
+        // We own this slot now
+        slot_p = &slot;
+        break;
+        }
+      }
+
+    if (slot_id == int32(sym_id))
+      {
+      // Cached - unless another thread is still busy publishing it
+      return is_slot_ready(slot.m_ready)
+        ? slot.m_name
+        : FName(sym.as_cstr(), add_if_missing ? FNAME_Add : FNAME_Find);
+      }
+    }
+
+  FName name(sym.as_cstr(), add_if_missing ? FNAME_Add : FNAME_Find);
+
+  if (slot_p)
+    {
+    // Only publish valid names so a name that is not known yet can be cached later
+    if (name != NAME_None)
+      {
+      slot_p->m_name = name;
+      publish_slot(slot_p->m_ready);
+      }
+    else
+      {
+      // Give slot back
+      FPlatformAtomics::InterlockedExchange(&slot_p->m_sym_id, int32(ASymbol_id_null));
+      }
+    }
+
+  return name;
+  }
+
+//---------------------------------------------------------------------------------------
+// Converts `FName` to `ASymbol` - looking it up in the cache first.
+// 
+// Names are keyed by their display index and number, so a hit is a single integer
+// compare. The string of the name - including any number suffix - is only built on a
+// miss. Game thread only since misses create symbols.
+ASymbol SkUENameCache::get_symbol(const FName & name)
+  {
+  int64 name_key = get_name_key(name);
+
+  if (name_key == 0)
+    {
+    return ASymbol::get_null();
+    }
+
+  if (!g_name_to_sym_p)
+    {
+    return FStringToASymbol(name.ToString());
+    }
+
+  // Look for existing entry or claim an empty slot
+  SkUENameToSymbolSlot * slot_p = nullptr;
+  uint32_t idx = (uint32_t(name.GetDisplayIndex()) * 0x9e3779b1u) ^ uint32_t(name.GetNumber());
+  for (uint32_t probe = 0u; probe < Probe_max; ++probe, ++idx)
+    {
+    SkUENameToSymbolSlot & slot = g_name_to_sym_p[idx & (Capacity - 1u)];
+    int64 slot_key = slot.m_name_key;
+
+    if (slot_key == 0)
+      {
+      slot_key = FPlatformAtomics::InterlockedCompareExchange(&slot.m_name_key, name_key, int64(0));
+      if (slot_key == 0)
+        {
+        // We own this slot now
+        slot_p = &slot;
+        break;
+        }
+      }
+
+    if (slot_key == name_key)
+      {
+      return is_slot_ready(slot.m_ready) ? slot.m_symbol : FStringToASymbol(name.ToString());
+      }
+    }
+
+  ASymbol sym = FStringToASymbol(name.ToString());
+
+  if (slot_p)
+    {
+    slot_p->m_symbol = sym;
+    publish_slot(slot_p->m_ready);
+    }
+
+  return sym;
+  }
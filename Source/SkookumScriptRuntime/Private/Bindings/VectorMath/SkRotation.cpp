@@ -13,7 +13,9 @@
 
 #include "SkRotation.hpp"
 #include "SkRotationAngles.hpp"
+#include "SkVector3.hpp"
 #include <SkookumScript/SkBoolean.hpp>
+#include <SkookumScript/SkReal.hpp>
 
 //=======================================================================================
 // Method Definitions
@@ -81,16 +83,200 @@ namespace SkRotation_Impl
       }
     }
 
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Rotation@=(Rotation rot) Boolean
+  static void mthd_op_equals(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkBoolean::new_instance(scope_p->this_as<SkRotation>() == scope_p->get_arg<SkRotation>(SkArg_1));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Rotation@~=(Rotation rot) Boolean
+  static void mthd_op_not_equal(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkBoolean::new_instance(scope_p->this_as<SkRotation>() != scope_p->get_arg<SkRotation>(SkArg_1));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Rotation@*(Rotation rot) Rotation
+  static void mthd_op_multiply(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkRotation::new_instance(scope_p->this_as<SkRotation>() * scope_p->get_arg<SkRotation>(SkArg_1));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Rotation@*=(Rotation rot) Rotation
+  static void mthd_op_multiply_assign(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    SkInstance * this_p = scope_p->get_this();
+
+    this_p->as<SkRotation>() *= scope_p->get_arg<SkRotation>(SkArg_1);
+
+    // Return this if result desired
+    if (result_pp)
+      {
+      this_p->reference();
+      *result_pp = this_p;
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Rotation@inverted() Rotation
+  static void mthd_inverted(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkRotation::new_instance(scope_p->this_as<SkRotation>().Inverse());
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Rotation@invert() Rotation
+  static void mthd_invert(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    SkInstance * this_p = scope_p->get_this();
+    FQuat & rotation = this_p->as<SkRotation>();
+
+    rotation = rotation.Inverse();
+
+    // Return this if result desired
+    if (result_pp)
+      {
+      this_p->reference();
+      *result_pp = this_p;
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Rotation@normalized() Rotation
+  static void mthd_normalized(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkRotation::new_instance(scope_p->this_as<SkRotation>().GetNormalized());
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Rotation@normalize() Rotation
+  static void mthd_normalize(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    SkInstance * this_p = scope_p->get_this();
+
+    this_p->as<SkRotation>().Normalize();
+
+    // Return this if result desired
+    if (result_pp)
+      {
+      this_p->reference();
+      *result_pp = this_p;
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Rotation@blended(Rotation rot, Real alpha) Rotation
+  static void mthd_blended(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkRotation::new_instance(FQuat::Slerp(
+        scope_p->this_as<SkRotation>(),
+        scope_p->get_arg<SkRotation>(SkArg_1),
+        scope_p->get_arg<SkReal>(SkArg_2)));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Rotation@blend(Rotation rot, Real alpha) Rotation
+  static void mthd_blend(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    SkInstance * this_p = scope_p->get_this();
+    FQuat & rotation = this_p->as<SkRotation>();
+
+    rotation = FQuat::Slerp(rotation, scope_p->get_arg<SkRotation>(SkArg_1), scope_p->get_arg<SkReal>(SkArg_2));
+
+    // Return this if result desired
+    if (result_pp)
+      {
+      this_p->reference();
+      *result_pp = this_p;
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Rotation@forward() Vector3
+  static void mthd_forward(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkVector3::new_instance(scope_p->this_as<SkRotation>().GetAxisX());
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Rotation@right() Vector3
+  static void mthd_right(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkVector3::new_instance(scope_p->this_as<SkRotation>().GetAxisY());
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Rotation@up() Vector3
+  static void mthd_up(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkVector3::new_instance(scope_p->this_as<SkRotation>().GetAxisZ());
+      }
+    }
+
   //---------------------------------------------------------------------------------------
 
   // Instance method array
   static const SkClass::MethodInitializerFunc methods_i[] =
     {
-      { "String",         mthd_String },
-      { "RotationAngles", mthd_RotationAngles },
+      { "String",           mthd_String },
+      { "RotationAngles",   mthd_RotationAngles },
+
+      { "equal?",           mthd_op_equals },
+      { "not_equal?",       mthd_op_not_equal },
+      { "multiply",         mthd_op_multiply },
+      { "multiply_assign",  mthd_op_multiply_assign },
+
+      { "inverted",         mthd_inverted },
+      { "invert",           mthd_invert },
+      { "normalized",       mthd_normalized },
+      { "normalize",        mthd_normalize },
+      { "blended",          mthd_blended },
+      { "blend",            mthd_blend },
+
+      { "forward",          mthd_forward },
+      { "right",            mthd_right },
+      { "up",               mthd_up },
 
-      { "zero?",          mthd_zeroQ },
-      { "zero",           mthd_zero },
+      { "zero?",            mthd_zeroQ },
+      { "zero",             mthd_zero },
     };
 
   } // namespace
@@ -13,6 +13,7 @@
 
 #include "SkRotationAngles.hpp"
 #include "SkRotation.hpp"
+#include "SkVector3.hpp"
 #include <SkookumScript/SkBoolean.hpp>
 #include <SkookumScript/SkReal.hpp>
 
@@ -115,6 +116,178 @@ namespace SkRotationAngles_Impl
       }
     }
 
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   RotationAngles@=(RotationAngles rot) Boolean
+  static void mthd_op_equals(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkBoolean::new_instance(scope_p->this_as<SkRotationAngles>() == scope_p->get_arg<SkRotationAngles>(SkArg_1));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   RotationAngles@~=(RotationAngles rot) Boolean
+  static void mthd_op_not_equal(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkBoolean::new_instance(scope_p->this_as<SkRotationAngles>() != scope_p->get_arg<SkRotationAngles>(SkArg_1));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   RotationAngles@+(RotationAngles rot) RotationAngles
+  static void mthd_op_add(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkRotationAngles::new_instance(scope_p->this_as<SkRotationAngles>() + scope_p->get_arg<SkRotationAngles>(SkArg_1));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   RotationAngles@+=(RotationAngles rot) RotationAngles
+  static void mthd_op_add_assign(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    SkInstance * this_p = scope_p->get_this();
+
+    this_p->as<SkRotationAngles>() += scope_p->get_arg<SkRotationAngles>(SkArg_1);
+
+    // Return this if result desired
+    if (result_pp)
+      {
+      this_p->reference();
+      *result_pp = this_p;
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   RotationAngles@-(RotationAngles rot) RotationAngles
+  static void mthd_op_subtract(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkRotationAngles::new_instance(scope_p->this_as<SkRotationAngles>() - scope_p->get_arg<SkRotationAngles>(SkArg_1));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   RotationAngles@-=(RotationAngles rot) RotationAngles
+  static void mthd_op_subtract_assign(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    SkInstance * this_p = scope_p->get_this();
+
+    this_p->as<SkRotationAngles>() -= scope_p->get_arg<SkRotationAngles>(SkArg_1);
+
+    // Return this if result desired
+    if (result_pp)
+      {
+      this_p->reference();
+      *result_pp = this_p;
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   RotationAngles@*(Real num) RotationAngles
+  static void mthd_op_multiply(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkRotationAngles::new_instance(scope_p->this_as<SkRotationAngles>() * scope_p->get_arg<SkReal>(SkArg_1));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   RotationAngles@*=(Real num) RotationAngles
+  static void mthd_op_multiply_assign(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    SkInstance * this_p = scope_p->get_this();
+
+    this_p->as<SkRotationAngles>() *= scope_p->get_arg<SkReal>(SkArg_1);
+
+    // Return this if result desired
+    if (result_pp)
+      {
+      this_p->reference();
+      *result_pp = this_p;
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   RotationAngles@normalized() RotationAngles
+  static void mthd_normalized(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkRotationAngles::new_instance(scope_p->this_as<SkRotationAngles>().GetNormalized());
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   RotationAngles@normalize() RotationAngles
+  static void mthd_normalize(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    SkInstance * this_p = scope_p->get_this();
+
+    this_p->as<SkRotationAngles>().Normalize();
+
+    // Return this if result desired
+    if (result_pp)
+      {
+      this_p->reference();
+      *result_pp = this_p;
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   RotationAngles@blended(RotationAngles rot, Real alpha) RotationAngles
+  static void mthd_blended(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkRotationAngles::new_instance(FMath::Lerp(
+        scope_p->this_as<SkRotationAngles>(),
+        scope_p->get_arg<SkRotationAngles>(SkArg_1),
+        scope_p->get_arg<SkReal>(SkArg_2)));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   RotationAngles@blend(RotationAngles rot, Real alpha) RotationAngles
+  static void mthd_blend(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    SkInstance * this_p = scope_p->get_this();
+    FRotator & rot = this_p->as<SkRotationAngles>();
+
+    rot = FMath::Lerp(rot, scope_p->get_arg<SkRotationAngles>(SkArg_1), scope_p->get_arg<SkReal>(SkArg_2));
+
+    // Return this if result desired
+    if (result_pp)
+      {
+      this_p->reference();
+      *result_pp = this_p;
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   RotationAngles@Vector3() Vector3
+  static void mthd_Vector3(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkVector3::new_instance(scope_p->this_as<SkRotationAngles>().Vector());
+      }
+    }
+
   //---------------------------------------------------------------------------------------
 
   // Instance method array
@@ -124,6 +297,21 @@ namespace SkRotationAngles_Impl
 
       { "String",             mthd_String },
       { "Rotation",           mthd_Rotation },
+      { "Vector3",            mthd_Vector3 },
+
+      { "equal?",             mthd_op_equals },
+      { "not_equal?",         mthd_op_not_equal },
+      { "add",                mthd_op_add },
+      { "add_assign",         mthd_op_add_assign },
+      { "subtract",           mthd_op_subtract },
+      { "subtract_assign",    mthd_op_subtract_assign },
+      { "multiply",           mthd_op_multiply },
+      { "multiply_assign",    mthd_op_multiply_assign },
+
+      { "normalized",         mthd_normalized },
+      { "normalize",          mthd_normalize },
+      { "blended",            mthd_blended },
+      { "blend",              mthd_blend },
 
       { "set",                mthd_set },
       { "zero?",              mthd_zeroQ },
@@ -14,6 +14,8 @@
 #include "SkTransform.hpp"
 #include "SkVector3.hpp"
 #include "SkRotation.hpp"
+#include <SkookumScript/SkBoolean.hpp>
+#include <SkookumScript/SkReal.hpp>
 
 //=======================================================================================
 // Method Definitions
@@ -60,13 +62,194 @@ namespace SkTransform_Impl
       }
     }
 
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Transform@*(Transform xform) Transform
+  static void mthd_op_multiply(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkTransform::new_instance(scope_p->this_as<SkTransform>() * scope_p->get_arg<SkTransform>(SkArg_1));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Transform@*=(Transform xform) Transform
+  static void mthd_op_multiply_assign(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    SkInstance * this_p = scope_p->get_this();
+
+    this_p->as<SkTransform>() *= scope_p->get_arg<SkTransform>(SkArg_1);
+
+    // Return this if result desired
+    if (result_pp)
+      {
+      this_p->reference();
+      *result_pp = this_p;
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Transform@inverted() Transform
+  static void mthd_inverted(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkTransform::new_instance(scope_p->this_as<SkTransform>().Inverse());
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Transform@invert() Transform
+  static void mthd_invert(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    SkInstance * this_p = scope_p->get_this();
+    FTransform & xform = this_p->as<SkTransform>();
+
+    xform = xform.Inverse();
+
+    // Return this if result desired
+    if (result_pp)
+      {
+      this_p->reference();
+      *result_pp = this_p;
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Transform@blended(Transform xform, Real alpha) Transform
+  static void mthd_blended(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      FTransform xform;
+
+      xform.Blend(scope_p->this_as<SkTransform>(), scope_p->get_arg<SkTransform>(SkArg_1), scope_p->get_arg<SkReal>(SkArg_2));
+      *result_pp = SkTransform::new_instance(xform);
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Transform@blend(Transform xform, Real alpha) Transform
+  static void mthd_blend(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    SkInstance * this_p = scope_p->get_this();
+
+    this_p->as<SkTransform>().BlendWith(scope_p->get_arg<SkTransform>(SkArg_1), scope_p->get_arg<SkReal>(SkArg_2));
+
+    // Return this if result desired
+    if (result_pp)
+      {
+      this_p->reference();
+      *result_pp = this_p;
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Transform@relative_to(Transform xform) Transform
+  static void mthd_relative_to(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkTransform::new_instance(scope_p->this_as<SkTransform>().GetRelativeTransform(scope_p->get_arg<SkTransform>(SkArg_1)));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Transform@transform_position(Vector3 pos) Vector3
+  static void mthd_transform_position(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkVector3::new_instance(scope_p->this_as<SkTransform>().TransformPosition(scope_p->get_arg<SkVector3>(SkArg_1)));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Transform@transform_direction(Vector3 dir) Vector3
+  static void mthd_transform_direction(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkVector3::new_instance(scope_p->this_as<SkTransform>().TransformVector(scope_p->get_arg<SkVector3>(SkArg_1)));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Transform@transform_rotation(Rotation rot) Rotation
+  static void mthd_transform_rotation(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkRotation::new_instance(scope_p->this_as<SkTransform>().TransformRotation(scope_p->get_arg<SkRotation>(SkArg_1)));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Transform@untransform_position(Vector3 pos) Vector3
+  static void mthd_untransform_position(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkVector3::new_instance(scope_p->this_as<SkTransform>().InverseTransformPosition(scope_p->get_arg<SkVector3>(SkArg_1)));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Transform@untransform_direction(Vector3 dir) Vector3
+  static void mthd_untransform_direction(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkVector3::new_instance(scope_p->this_as<SkTransform>().InverseTransformVector(scope_p->get_arg<SkVector3>(SkArg_1)));
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Transform@near?(Transform xform, Real tolerance: 0.0001) Boolean
+  static void mthd_nearQ(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      *result_pp = SkBoolean::new_instance(scope_p->this_as<SkTransform>().Equals(
+        scope_p->get_arg<SkTransform>(SkArg_1),
+        scope_p->get_arg<SkReal>(SkArg_2)));
+      }
+    }
+
   //---------------------------------------------------------------------------------------
 
   // Instance method array
   static const SkClass::MethodInitializerFunc methods_i[] =
     {
-      { "String",       mthd_String },
-      { "identity",     mthd_identity },
+      { "String",                 mthd_String },
+      { "identity",               mthd_identity },
+
+      { "multiply",               mthd_op_multiply },
+      { "multiply_assign",        mthd_op_multiply_assign },
+
+      { "inverted",               mthd_inverted },
+      { "invert",                 mthd_invert },
+      { "blended",                mthd_blended },
+      { "blend",                  mthd_blend },
+      { "relative_to",            mthd_relative_to },
+
+      { "transform_position",     mthd_transform_position },
+      { "transform_direction",    mthd_transform_direction },
+      { "transform_rotation",     mthd_transform_rotation },
+      { "untransform_position",   mthd_untransform_position },
+      { "untransform_direction",  mthd_untransform_direction },
+
+      { "near?",                  mthd_nearQ },
     };
 
   } // namespace
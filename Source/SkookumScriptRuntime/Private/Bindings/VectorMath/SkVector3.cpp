@@ -16,6 +16,8 @@
 #include "SkTransform.hpp"
 #include "SkRotationAngles.hpp"
 #include <SkookumScript/SkBoolean.hpp>
+#include <SkookumScript/SkInteger.hpp>
+#include <SkookumScript/SkList.hpp>
 #include <SkookumScript/SkReal.hpp>
 
 //=======================================================================================
@@ -529,6 +531,341 @@ namespace SkVector3_Impl
     }
   */
 
+  //=======================================================================================
+  // Batch operations on List{Vector3}
+  //=======================================================================================
+
+  //---------------------------------------------------------------------------------------
+  // Scratch buffers for the batch operations - the positions of a list are gathered into
+  // separate x, y and z arrays so the kernels can process four of them per SIMD register
+  // rather than chasing the instance of each element.  Arrays are padded with zeros to a
+  // multiple of four.  Only used on the game thread and kept between calls so they do
+  // not allocate once grown.
+  struct Batch
+    {
+    TArray<float> m_xs;
+    TArray<float> m_ys;
+    TArray<float> m_zs;
+    TArray<float> m_dist_sqs;  // Squared distances computed by compute_dist_sqs()
+    uint32_t      m_count;
+    uint32_t      m_padded;
+    };
+
+  static Batch s_batch;
+
+  //---------------------------------------------------------------------------------------
+  // Gathers the positions of all Vector3 instances in list into s_batch
+  static void gather(const SkInstanceList & list)
+    {
+    uint32_t count  = list.get_length();
+    uint32_t padded = (count + 3u) & ~3u;
+
+    s_batch.m_xs.SetNumUninitialized(padded, false);
+    s_batch.m_ys.SetNumUninitialized(padded, false);
+    s_batch.m_zs.SetNumUninitialized(padded, false);
+    s_batch.m_count  = count;
+    s_batch.m_padded = padded;
+
+    float * xs_p = s_batch.m_xs.GetData();
+    float * ys_p = s_batch.m_ys.GetData();
+    float * zs_p = s_batch.m_zs.GetData();
+    SkInstance ** elems_pp = list.get_array();
+
+    for (uint32_t idx = 0u; idx < count; idx++)
+      {
+      const FVector & vec = elems_pp[idx]->as<SkVector3>();
+
+      xs_p[idx] = vec.X;
+      ys_p[idx] = vec.Y;
+      zs_p[idx] = vec.Z;
+      }
+
+    for (uint32_t idx = count; idx < padded; idx++)
+      {
+      xs_p[idx] = 0.0f;
+      ys_p[idx] = 0.0f;
+      zs_p[idx] = 0.0f;
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // Computes the squared distances from pos to the gathered positions into
+  // s_batch.m_dist_sqs.  The padding is set to the first distance so it does not change
+  // the result of a min or max over all of them.
+  static void compute_dist_sqs(const FVector & pos)
+    {
+    uint32_t padded = s_batch.m_padded;
+
+    s_batch.m_dist_sqs.SetNumUninitialized(padded, false);
+
+    const float * xs_p       = s_batch.m_xs.GetData();
+    const float * ys_p       = s_batch.m_ys.GetData();
+    const float * zs_p       = s_batch.m_zs.GetData();
+    float *       dist_sqs_p = s_batch.m_dist_sqs.GetData();
+    VectorRegister pos_x = VectorLoadFloat1(&pos.X);
+    VectorRegister pos_y = VectorLoadFloat1(&pos.Y);
+    VectorRegister pos_z = VectorLoadFloat1(&pos.Z);
+
+    for (uint32_t idx = 0u; idx < padded; idx += 4u)
+      {
+      VectorRegister delta_x = VectorSubtract(VectorLoad(xs_p + idx), pos_x);
+      VectorRegister delta_y = VectorSubtract(VectorLoad(ys_p + idx), pos_y);
+      VectorRegister delta_z = VectorSubtract(VectorLoad(zs_p + idx), pos_z);
+      VectorRegister dist_sq = VectorMultiply(delta_x, delta_x);
+
+      dist_sq = VectorMultiplyAdd(delta_y, delta_y, dist_sq);
+      dist_sq = VectorMultiplyAdd(delta_z, delta_z, dist_sq);
+      VectorStore(dist_sq, dist_sqs_p + idx);
+      }
+
+    for (uint32_t idx = s_batch.m_count; idx < padded; idx++)
+      {
+      dist_sqs_p[idx] = dist_sqs_p[0];
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // Returns the sum of the gathered positions
+  static FVector compute_sum()
+    {
+    const float *  xs_p  = s_batch.m_xs.GetData();
+    const float *  ys_p  = s_batch.m_ys.GetData();
+    const float *  zs_p  = s_batch.m_zs.GetData();
+    VectorRegister sum_x = VectorZero();
+    VectorRegister sum_y = VectorZero();
+    VectorRegister sum_z = VectorZero();
+
+    for (uint32_t idx = 0u; idx < s_batch.m_padded; idx += 4u)
+      {
+      sum_x = VectorAdd(sum_x, VectorLoad(xs_p + idx));
+      sum_y = VectorAdd(sum_y, VectorLoad(ys_p + idx));
+      sum_z = VectorAdd(sum_z, VectorLoad(zs_p + idx));
+      }
+
+    float lanes_x[4];
+    float lanes_y[4];
+    float lanes_z[4];
+
+    VectorStore(sum_x, lanes_x);
+    VectorStore(sum_y, lanes_y);
+    VectorStore(sum_z, lanes_z);
+
+    return FVector(
+      (lanes_x[0] + lanes_x[1]) + (lanes_x[2] + lanes_x[3]),
+      (lanes_y[0] + lanes_y[1]) + (lanes_y[2] + lanes_y[3]),
+      (lanes_z[0] + lanes_z[1]) + (lanes_z[2] + lanes_z[3]));
+    }
+
+  //---------------------------------------------------------------------------------------
+  // Returns the smallest (or largest) squared distance computed by compute_dist_sqs()
+  static float reduce_dist_sqs(bool max_b)
+    {
+    const float *  dist_sqs_p = s_batch.m_dist_sqs.GetData();
+    VectorRegister result     = VectorLoad(dist_sqs_p);
+
+    for (uint32_t idx = 4u; idx < s_batch.m_padded; idx += 4u)
+      {
+      result = max_b ? VectorMax(result, VectorLoad(dist_sqs_p + idx)) : VectorMin(result, VectorLoad(dist_sqs_p + idx));
+      }
+
+    float lanes[4];
+
+    VectorStore(result, lanes);
+
+    return max_b
+      ? FMath::Max(FMath::Max(lanes[0], lanes[1]), FMath::Max(lanes[2], lanes[3]))
+      : FMath::Min(FMath::Min(lanes[0], lanes[1]), FMath::Min(lanes[2], lanes[3]));
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Vector3@nearest(List{Vector3} points, Integer count: 1) List{Integer}
+  static void mthd_nearest(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      struct Candidate
+        {
+        float    m_dist_sq;
+        uint32_t m_idx;
+        };
+
+      gather(scope_p->get_arg<SkList>(SkArg_1));
+      compute_dist_sqs(scope_p->this_as<SkVector3>());
+
+      uint32_t count = uint32_t(FMath::Clamp<SkIntegerType>(scope_p->get_arg<SkInteger>(SkArg_2), 0, s_batch.m_count));
+
+      // Keep the nearest count candidates in a heap with the farthest of them on top
+      static TArray<Candidate> s_heap;
+      auto farther = [](const Candidate & lhs, const Candidate & rhs) { return lhs.m_dist_sq > rhs.m_dist_sq; };
+      const float * dist_sqs_p = s_batch.m_dist_sqs.GetData();
+
+      s_heap.Reset(count);
+      for (uint32_t idx = 0u; idx < s_batch.m_count && count; idx++)
+        {
+        if (uint32_t(s_heap.Num()) < count)
+          {
+          s_heap.HeapPush(Candidate{ dist_sqs_p[idx], idx }, farther);
+          }
+        else if (dist_sqs_p[idx] < s_heap.HeapTop().m_dist_sq)
+          {
+          s_heap.HeapPopDiscard(farther, false);
+          s_heap.HeapPush(Candidate{ dist_sqs_p[idx], idx }, farther);
+          }
+        }
+
+      // Nearest first - ties in list order
+      s_heap.Sort([](const Candidate & lhs, const Candidate & rhs)
+        {
+        return (lhs.m_dist_sq < rhs.m_dist_sq) || ((lhs.m_dist_sq == rhs.m_dist_sq) && (lhs.m_idx < rhs.m_idx));
+        });
+
+      SkInstance *          list_p    = SkList::new_instance(s_heap.Num());
+      APArray<SkInstance> & instances = list_p->as<SkList>().get_instances();
+
+      for (const Candidate & candidate : s_heap)
+        {
+        // This instance is already refcounted so directly append to underlying array
+        instances.append(*SkInteger::new_instance(SkIntegerType(candidate.m_idx)));
+        }
+
+      *result_pp = list_p;
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Vector3@within(List{Vector3} points, Real radius) List{Integer}
+  static void mthd_within(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      gather(scope_p->get_arg<SkList>(SkArg_1));
+      compute_dist_sqs(scope_p->this_as<SkVector3>());
+
+      SkInstance *          list_p     = SkList::new_instance();
+      APArray<SkInstance> & instances  = list_p->as<SkList>().get_instances();
+      const float *         dist_sqs_p = s_batch.m_dist_sqs.GetData();
+      float                 radius     = scope_p->get_arg<SkReal>(SkArg_2);
+      float                 radius_sq  = radius * radius;
+      VectorRegister        radius_sqs = VectorLoadFloat1(&radius_sq);
+
+      for (uint32_t idx = 0u; idx < s_batch.m_count; idx += 4u)
+        {
+        // One bit per lane within the radius
+        uint32_t mask = uint32_t(VectorMaskBits(VectorCompareLE(VectorLoad(dist_sqs_p + idx), radius_sqs)));
+
+        for (uint32_t lane = 0u; mask && (idx + lane < s_batch.m_count); lane++, mask >>= 1u)
+          {
+          if (mask & 1u)
+            {
+            instances.append(*SkInteger::new_instance(SkIntegerType(idx + lane)));
+            }
+          }
+        }
+
+      *result_pp = list_p;
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Vector3@distance_min(List{Vector3} points) Real
+  static void mthd_distance_min(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      float dist = 0.0f;
+
+      gather(scope_p->get_arg<SkList>(SkArg_1));
+      if (s_batch.m_count)
+        {
+        compute_dist_sqs(scope_p->this_as<SkVector3>());
+        dist = FMath::Sqrt(reduce_dist_sqs(false));
+        }
+
+      *result_pp = SkReal::new_instance(dist);
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Vector3@distance_max(List{Vector3} points) Real
+  static void mthd_distance_max(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      float dist = 0.0f;
+
+      gather(scope_p->get_arg<SkList>(SkArg_1));
+      if (s_batch.m_count)
+        {
+        compute_dist_sqs(scope_p->this_as<SkVector3>());
+        dist = FMath::Sqrt(reduce_dist_sqs(true));
+        }
+
+      *result_pp = SkReal::new_instance(dist);
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Vector3@sum(List{Vector3} points) Vector3
+  static void mthdc_sum(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      gather(scope_p->get_arg<SkList>(SkArg_1));
+      *result_pp = SkVector3::new_instance(compute_sum());
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Vector3@centroid(List{Vector3} points) Vector3
+  static void mthdc_centroid(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    // Do nothing if result not desired
+    if (result_pp)
+      {
+      gather(scope_p->get_arg<SkList>(SkArg_1));
+
+      FVector centroid = compute_sum();
+
+      if (s_batch.m_count)
+        {
+        centroid /= float(s_batch.m_count);
+        }
+
+      *result_pp = SkVector3::new_instance(centroid);
+      }
+    }
+
+  //---------------------------------------------------------------------------------------
+  // # Skookum:   Vector3@transform_all(List{Vector3} points, Transform xform) List{Vector3}
+  static void mthdc_transform_all(SkInvokedMethod * scope_p, SkInstance ** result_pp)
+    {
+    SkInstance *     list_p = scope_p->get_arg(SkArg_1);
+    SkInstanceList & list   = list_p->as<SkList>();
+
+    // Convert once - the matrix transforms a position with a single SIMD multiply
+    FMatrix       matrix   = scope_p->get_arg<SkTransform>(SkArg_2).ToMatrixWithScale();
+    SkInstance ** elems_pp = list.get_array();
+
+    for (uint32_t idx = 0u, count = list.get_length(); idx < count; idx++)
+      {
+      FVector & vec = elems_pp[idx]->as<SkVector3>();
+
+      vec = matrix.TransformPosition(vec);
+      }
+
+    // Return the list if result desired
+    if (result_pp)
+      {
+      list_p->reference();
+      *result_pp = list_p;
+      }
+    }
+
   //---------------------------------------------------------------------------------------
 
   // Instance method array
@@ -583,6 +920,19 @@ namespace SkVector3_Impl
       { "RotationAngles",   mthd_RotationAngles },
       //{ "angle",            mthd_angle },
       //{ "normalize",        mthd_normalize },
+
+      { "nearest",          mthd_nearest },
+      { "within",           mthd_within },
+      { "distance_min",     mthd_distance_min },
+      { "distance_max",     mthd_distance_max },
+    };
+
+  // Class method array
+  static const SkClass::MethodInitializerFunc methods_c[] =
+    {
+      { "sum",              mthdc_sum },
+      { "centroid",         mthdc_centroid },
+      { "transform_all",    mthdc_transform_all },
     };
 
   } // namespace
@@ -593,6 +943,7 @@ void SkVector3::register_bindings()
   tBindingBase::register_bindings("Vector3");
 
   ms_class_p->register_method_func_bulk(SkVector3_Impl::methods_i, A_COUNT_OF(SkVector3_Impl::methods_i), SkBindFlag_instance_no_rebind);
+  ms_class_p->register_method_func_bulk(SkVector3_Impl::methods_c, A_COUNT_OF(SkVector3_Impl::methods_c), SkBindFlag_class_no_rebind);
 
   ms_class_p->register_raw_accessor_func(&SkUEClassBindingHelper::access_raw_data_struct<SkVector3>);
   SkUEClassBindingHelper::resolve_raw_data_struct(ms_class_p, TEXT("Vector"));
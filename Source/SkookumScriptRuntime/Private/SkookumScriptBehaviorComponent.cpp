@@ -20,6 +20,8 @@
 #include <SkUEEEndPlayReason.generated.hpp>
 
 #include "Bindings/Engine/SkUESkookumScriptBehaviorComponent.hpp"
+#include "Bindings/SkUERuntime.hpp"
+#include "Bindings/SkUEProfiler.hpp"
 
 
 //=======================================================================================
@@ -99,7 +101,7 @@ void USkookumScriptBehaviorComponent::delete_sk_instance()
   {
   SK_ASSERTX(m_component_instance_p, "No Sk instance to delete!");
   m_component_instance_p->clear_coroutines();
-  m_component_instance_p->dereference();
+  SkUERuntime::get_singleton()->dereference_deferred(m_component_instance_p);
   m_component_instance_p = nullptr;
   }
 
@@ -156,10 +158,14 @@ void USkookumScriptBehaviorComponent::InitializeComponent()
 
       create_sk_instance();
       m_component_instance_p->get_class()->resolve_raw_data();
+
+      SKUE_PROFILE_SCOPE(m_component_instance_p->get_class()->get_name(), ASymbolX_ctor);
       m_component_instance_p->call_default_constructor();
       }
 
     m_component_instance_p->as<SkUESkookumScriptBehaviorComponent>() = this;
+
+    SKUE_PROFILE_SCOPE(m_component_instance_p->get_class()->get_name(), ms_symbol_on_attach);
     m_component_instance_p->method_call(ms_symbol_on_attach);
     }
   }
@@ -175,6 +181,7 @@ void USkookumScriptBehaviorComponent::BeginPlay()
 
     SK_ASSERTX(m_component_instance_p != nullptr, a_str_format("SkookumScriptBehaviorComponent '%S' on actor '%S' has no SkookumScript instance upon BeginPlay. This means its InitializeComponent() method was never called during initialization. Please check your initialization sequence and make sure this component gets properly initialized.", *GetName(), *GetOwner()->GetName()));
 
+    SKUE_PROFILE_SCOPE(m_component_instance_p->get_class()->get_name(), ms_symbol_on_begin_play);
     m_component_instance_p->method_call(ms_symbol_on_begin_play);
     }
   }
@@ -183,7 +190,10 @@ void USkookumScriptBehaviorComponent::BeginPlay()
 
 void USkookumScriptBehaviorComponent::EndPlay(const EEndPlayReason::Type end_play_reason)
   {
-  m_component_instance_p->method_call(ms_symbol_on_end_play, SkUEEEndPlayReason::new_instance(end_play_reason));
+    {
+    SKUE_PROFILE_SCOPE(m_component_instance_p->get_class()->get_name(), ms_symbol_on_end_play);
+    m_component_instance_p->method_call(ms_symbol_on_end_play, SkUEEEndPlayReason::new_instance(end_play_reason));
+    }
 
   Super::EndPlay(end_play_reason);
   }
@@ -197,7 +207,10 @@ void USkookumScriptBehaviorComponent::UninitializeComponent()
     {
     SK_ASSERTX(SkookumScript::get_initialization_level() >= SkookumScript::InitializationLevel_gameplay, "SkookumScript must be in gameplay mode when UninitializeComponent() is invoked.");
 
-    m_component_instance_p->method_call(ms_symbol_on_detach);
+      {
+      SKUE_PROFILE_SCOPE(m_component_instance_p->get_class()->get_name(), ms_symbol_on_detach);
+      m_component_instance_p->method_call(ms_symbol_on_detach);
+      }
     m_component_instance_p->as<SkUESkookumScriptBehaviorComponent>() = nullptr;
 
     if (m_is_instance_externally_owned)
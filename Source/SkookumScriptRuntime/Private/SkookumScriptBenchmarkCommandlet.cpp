@@ -0,0 +1,687 @@
+//=======================================================================================
+// SkookumScript Plugin for Unreal Engine 4
+// Copyright (c) 2016 Agog Labs Inc. All rights reserved.
+//
+// Commandlet running a standard set of scripting benchmarks
+//=======================================================================================
+
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include "SkookumScriptBenchmarkCommandlet.h"
+#include "ISkookumScriptRuntime.h"
+
+#include "Bindings/Engine/SkUEActor.hpp"
+
+#include "Async/ParallelFor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#include <AgogCore/AObjReusePool.hpp>
+#include <AgogCore/AObjReusePoolConcurrent.hpp>
+#include <AgogCore/AObjReusePoolTrimmable.hpp>
+#include <AgogCore/APSorted.hpp>
+#include <SkookumScript/SkBrain.hpp>
+#include <SkookumScript/SkClass.hpp>
+#include <SkookumScript/SkInteger.hpp>
+#include <SkookumScript/SkInvokedCoroutine.hpp>
+#include <SkookumScript/SkMind.hpp>
+#include <SkookumScript/SkReal.hpp>
+#include <SkookumScript/SkSymbolDefs.hpp>
+
+
+//=======================================================================================
+// Local Global Structures
+//=======================================================================================
+
+namespace
+{
+
+  enum
+    {
+    Benchmark_version = 4,     // Bump when workloads change so old baselines are not compared
+
+    Actor_count       = 100,   // Actors spawned in the benchmark world
+    Pool_batch        = 64,    // Objects allocated at once before recycling them again
+    Pool_initial_size = 256,
+    Pool_expand_size  = 256,
+    Trim_steps        = 1024,  // Free objects visited per trim() call
+    Lookup_keys       = 4096,  // Random keys cycled through by the lookup workloads - power of 2
+    Load_existing_div = 4,     // Elements already in the table per element loaded by the load workloads
+    Churn_frames_max  = 100    // Frames to wait for spawned coroutines to complete
+    };
+
+  const float Frame_delta = 1.0f / 60.0f;
+
+  //---------------------------------------------------------------------------------------
+  // Object managed by the pool workloads - about the size of an SkInstance
+  struct BenchObject
+    {
+    BenchObject * m_next_p;
+    uint64        m_payload[5];
+
+    BenchObject ** get_pool_unused_next() { return &m_next_p; }
+    };
+
+  //---------------------------------------------------------------------------------------
+  // Element of the lookup workloads - keyed by an id like ASymbolRef
+  struct BenchKeyed
+    {
+    uint32 m_id;
+    uint64 m_payload[3];
+
+    operator uint32_t () const { return m_id; }
+    };
+
+  // Keeps the lookup results alive so the lookups are not optimized away
+  volatile uint32 s_lookup_sink = 0u;
+
+} // namespace
+
+
+//=======================================================================================
+// Method Definitions
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+
+USkookumScriptBenchmarkCommandlet::USkookumScriptBenchmarkCommandlet(const FObjectInitializer & object_initializer)
+  : Super(object_initializer)
+  , m_world_p(nullptr)
+  , m_benchmark_class_p(nullptr)
+  , m_scale(1.0f)
+  , m_repeat(3)
+  , m_thread_count(4)
+  , m_failed_b(false)
+  {
+  IsClient        = false;
+  IsServer        = false;
+  IsEditor        = false;
+  LogToConsole    = true;
+  ShowErrorCount  = true;
+  }
+
+//---------------------------------------------------------------------------------------
+
+int32 USkookumScriptBenchmarkCommandlet::Main(const FString & params)
+  {
+  FString plugin_path = IPluginManager::Get().FindPlugin(TEXT("SkookumScript"))->GetBaseDir();
+  FString output_path = FPaths::ProfilingDir() / TEXT("SkookumScript") / TEXT("Benchmark.json");
+  FString baseline_path = plugin_path / TEXT("Scripts") / TEXT("Benchmark") / TEXT("Baseline.json");
+  float   tolerance = 0.1f;
+
+  FParse::Value(*params, TEXT("Output="), output_path);
+  // A baseline asked for explicitly must exist - see below
+  bool gated_b = FParse::Value(*params, TEXT("Baseline="), baseline_path) || FParse::Param(*params, TEXT("Gated"));
+  FParse::Value(*params, TEXT("Tolerance="), tolerance);
+  FParse::Value(*params, TEXT("Scale="), m_scale);
+  FParse::Value(*params, TEXT("Repeat="), m_repeat);
+  FParse::Value(*params, TEXT("Threads="), m_thread_count);
+  m_repeat       = FMath::Max(m_repeat, 1);
+  m_thread_count = FMath::Clamp(m_thread_count, 1, AORPOOL_CONCURRENT_THREAD_SLOTS - 1);
+
+  ISkookumScriptRuntime & runtime = FModuleManager::LoadModuleChecked<ISkookumScriptRuntime>("SkookumScriptRuntime");
+  if (runtime.is_skookum_disabled())
+    {
+    UE_LOG(LogSkookum, Error, TEXT("SkookumScript is disabled - make sure the compiled binaries exist."));
+    return 1;
+    }
+
+  if (!setup_world())
+    {
+    teardown_world();
+    return 1;
+    }
+
+  run_script_workloads();
+  run_native_workloads();
+
+  teardown_world();
+
+  for (const Result & result : m_results)
+    {
+    UE_LOG(LogSkookum, Display, TEXT("  %-20s %10u iterations %10.3f ms %10.1f ns/iteration"), *result.m_name, result.m_iterations, result.m_msecs, result.get_nsecs_per_iteration());
+    }
+
+  if (FParse::Param(*params, TEXT("UpdateBaseline")))
+    {
+    if (!write_results(baseline_path))
+      {
+      return 1;
+      }
+    }
+  else
+    {
+    write_results(output_path);
+
+    if (FParse::Param(*params, TEXT("Ungated")))
+      {
+      UE_LOG(LogSkookum, Warning, TEXT("SkookumScript benchmarks ran ungated - results were not compared with a baseline."));
+      }
+    else if (!gated_b && !FPaths::FileExists(baseline_path))
+      {
+      // No baseline recorded yet for the plugin - nothing to gate on
+      UE_LOG(LogSkookum, Warning, TEXT("No SkookumScript benchmark baseline '%s' yet - results were not compared. Record one on the reference machine with -UpdateBaseline."), *baseline_path);
+      }
+    else if (!compare_to_baseline(baseline_path, tolerance))
+      {
+      m_failed_b = true;
+      }
+    }
+
+  return m_failed_b ? 1 : 0;
+  }
+
+//---------------------------------------------------------------------------------------
+// Times a workload - it is run several times and the fastest run counts
+//
+// #Params:
+//   name: name of workload in the results
+//   iterations: iterations at a scale of 1.0
+//   workload_f: runs the workload for the given number of iterations
+//   setup_f: optional preparation before each run that is not timed
+void USkookumScriptBenchmarkCommandlet::run_workload(const FString & name, uint32 iterations, const tWorkloadFunc & workload_f, const tWorkloadFunc & setup_f)
+  {
+  iterations = FMath::Max(uint32(iterations * m_scale), 1u);
+
+  double best_secs = DBL_MAX;
+  for (int32 run = 0; run < m_repeat; ++run)
+    {
+    if (setup_f)
+      {
+      setup_f(iterations);
+      }
+
+    double start_secs = FPlatformTime::Seconds();
+    workload_f(iterations);
+    best_secs = FMath::Min(best_secs, FPlatformTime::Seconds() - start_secs);
+    }
+
+  Result result;
+  result.m_name       = name;
+  result.m_iterations = iterations;
+  result.m_msecs      = best_secs * 1000.0;
+  m_results.Add(result);
+  }
+
+//---------------------------------------------------------------------------------------
+// Times a class method of `SkookumBenchmark` that takes the iteration count as its last
+// argument and optionally an actor before it
+void USkookumScriptBenchmarkCommandlet::run_script_workload(const FString & name, uint32 iterations, bool pass_actor_b)
+  {
+  ASymbol method_name = ASymbol::create(TCHAR_TO_ANSI(*name));
+
+  if (!m_benchmark_class_p->find_class_method(method_name))
+    {
+    UE_LOG(LogSkookum, Error, TEXT("Benchmark workload 'SkookumBenchmark@%s()' not found - the Benchmark overlay might be out of date."), *name);
+    m_failed_b = true;
+    return;
+    }
+
+  SkMetaClass & benchmark_class = m_benchmark_class_p->get_metaclass();
+  AActor *      actor_p = m_actors[0];
+
+  run_workload(name, iterations, [&benchmark_class, &method_name, actor_p, pass_actor_b](uint32 count)
+    {
+    SkInstance * args_p[2];
+    uint32_t     arg_count = 0u;
+
+    if (pass_actor_b)
+      {
+      args_p[arg_count++] = SkUEActor::new_instance(actor_p);
+      }
+    args_p[arg_count++] = SkInteger::new_instance(SkIntegerType(count));
+
+    benchmark_class.method_call(method_name, args_p, arg_count);
+    });
+  }
+
+//---------------------------------------------------------------------------------------
+// Runs the workloads that are driven by scripts
+void USkookumScriptBenchmarkCommandlet::run_script_workloads()
+  {
+  run_script_workload(TEXT("method_dispatch"),   200000u);
+  run_script_workload(TEXT("vector_math"),       100000u);
+  run_script_workload(TEXT("list_ops"),          20000u);
+  run_script_workload(TEXT("raw_member_access"), 100000u, true);
+  run_script_workload(TEXT("bp_events"),         50000u,  true);
+  run_script_workload(TEXT("bp_events_loop"),    500u);
+  run_script_workload(TEXT("bp_events_batch"),   500u);
+  run_script_workload(TEXT("actor_queries"),     2000u);
+  run_script_workload(TEXT("crowd_loop"),        200u);
+  run_script_workload(TEXT("crowd_batch"),       200u);
+
+  // Blueprint calling into script
+  UFunction * function_p = AActor::StaticClass()->FindFunctionByName(FName(TEXT("Actor @ bench_bp_call")));
+  if (!function_p)
+    {
+    UE_LOG(LogSkookum, Error, TEXT("Benchmark workload 'Actor@bench_bp_call()' was not exposed to Blueprints - the Benchmark overlay might be out of date."));
+    m_failed_b = true;
+    }
+  else
+    {
+    AActor * actor_p = m_actors[0];
+
+    run_workload(TEXT("bp_calls"), 100000u, [actor_p, function_p](uint32 count)
+      {
+      struct
+        {
+        int32 value;
+        int32 result;
+        } call_params = { 0, 0 };
+
+      check(function_p->ParmsSize == sizeof(call_params));
+
+      for (uint32 idx = 0u; idx < count; ++idx)
+        {
+        call_params.value = int32(idx);
+        actor_p->ProcessEvent(function_p, &call_params);
+        }
+      });
+    }
+
+  // Coroutines spawned all at once and updated by SkMind::update_all() until completed
+  run_workload(TEXT("coroutine_churn"), 20000u, [this](uint32 count)
+    {
+    SkMind * mind_p     = SkookumScript::get_master_mind();
+    uint32_t idle_count = mind_p->get_invoked_coroutines().get_count();
+
+    for (uint32 idx = 0u; idx < count; ++idx)
+      {
+      mind_p->coroutine_call(ASymbol__wait, SkReal::new_instance(0.0f), false);
+      }
+
+    uint32 frame = 0u;
+    do
+      {
+      tick_world();
+      }
+    while (mind_p->get_invoked_coroutines().get_count() > idle_count && ++frame < Churn_frames_max);
+    });
+  }
+
+//---------------------------------------------------------------------------------------
+// Runs the workloads that only exercise native code
+void USkookumScriptBenchmarkCommandlet::run_native_workloads()
+  {
+  // Allocate and recycle batches of objects on the game thread
+  run_workload(TEXT("pool_alloc_free"), 2000000u, [](uint32 count)
+    {
+    AObjReusePool<BenchObject> pool(Pool_initial_size, Pool_expand_size);
+    BenchObject *              objs_p[Pool_batch];
+
+    for (uint32 done = 0u; done < count; done += Pool_batch)
+      {
+      for (uint32 idx = 0u; idx < Pool_batch; ++idx)
+        {
+        objs_p[idx] = pool.allocate();
+        }
+      for (uint32 idx = Pool_batch; idx > 0u; --idx)
+        {
+        pool.recycle(objs_p[idx - 1u]);
+        }
+      }
+    });
+
+  // Same on several threads at once sharing one concurrent pool - compare with the
+  // above to see the cost of the thread caches
+  int32 thread_count = m_thread_count;
+  run_workload(TEXT("pool_concurrent"), 2000000u, [thread_count](uint32 count)
+    {
+    AObjReusePoolConcurrent<BenchObject> pool(Pool_initial_size, Pool_expand_size);
+    uint32                               thread_iterations = count / thread_count;
+
+    ParallelFor(thread_count, [&pool, thread_iterations](int32 thread_idx)
+      {
+      BenchObject * objs_p[Pool_batch];
+
+      for (uint32 done = 0u; done < thread_iterations; done += Pool_batch)
+        {
+        for (uint32 idx = 0u; idx < Pool_batch; ++idx)
+          {
+          objs_p[idx] = pool.allocate();
+          }
+        for (uint32 idx = Pool_batch; idx > 0u; --idx)
+          {
+          pool.recycle(objs_p[idx - 1u]);
+          }
+        }
+
+      pool.flush_thread_cache();
+      });
+    });
+
+  // Give the expansion blocks of a usage spike back - only the trim is timed
+  TUniquePtr<AObjReusePoolTrimmable<BenchObject>> trim_pool_p;
+  run_workload(TEXT("pool_trim"), 200000u,
+    [&trim_pool_p](uint32 count)
+      {
+      while (trim_pool_p->trim(Trim_steps) || trim_pool_p->is_trimming())
+        {
+        }
+      },
+    [&trim_pool_p](uint32 count)
+      {
+      trim_pool_p = MakeUnique<AObjReusePoolTrimmable<BenchObject>>(Pool_initial_size, Pool_expand_size);
+      trim_pool_p->set_trim_keep_free(0u);
+
+      TArray<BenchObject *> objs;
+      objs.SetNumUninitialized(count);
+      for (uint32 idx = 0u; idx < count; ++idx)
+        {
+        objs[idx] = trim_pool_p->allocate();
+        }
+      for (BenchObject * obj_p : objs)
+        {
+        trim_pool_p->recycle(obj_p);
+        }
+      });
+  trim_pool_p.Reset();
+
+  // Key lookups in small to very large sorted tables
+  run_lookup_workloads(1000u);
+  run_lookup_workloads(10000u);
+  run_lookup_workloads(100000u);
+
+  // Loading a batch into a table - about as many classes and symbols as a large project
+  run_load_workloads(20000u);
+  run_load_workloads(100000u);
+  }
+
+//---------------------------------------------------------------------------------------
+// Times key lookups in a sorted table of the given length - with APSortedLogical, which
+// compares via the elements like the class and member tables
+void USkookumScriptBenchmarkCommandlet::run_lookup_workloads(uint32 table_length)
+  {
+  FRandomStream random(int32(table_length));
+
+  // Allocate elements in random order so table neighbours are not memory neighbours -
+  // like symbols and classes created over time
+  TArray<uint32> ids;
+  ids.SetNumUninitialized(table_length);
+  uint32 id = 0u;
+  for (uint32 idx = 0u; idx < table_length; ++idx)
+    {
+    id += 1u + uint32(random.RandHelper(16));
+    ids[idx] = id;
+    }
+  for (uint32 idx = table_length - 1u; idx > 0u; --idx)
+    {
+    ids.Swap(idx, random.RandHelper(idx + 1u));
+    }
+
+  TArray<TUniquePtr<BenchKeyed>> elems;
+  elems.Reserve(table_length);
+  for (uint32 elem_id : ids)
+    {
+    elems.Add(MakeUnique<BenchKeyed>());
+    elems.Last()->m_id = elem_id;
+    }
+  elems.Sort([](const TUniquePtr<BenchKeyed> & lhs, const TUniquePtr<BenchKeyed> & rhs) { return lhs->m_id < rhs->m_id; });
+
+  APSortedLogical<BenchKeyed, uint32_t> sorted;
+  sorted.ensure_size(table_length);
+  for (const TUniquePtr<BenchKeyed> & elem_p : elems)
+    {
+    sorted.append(*elem_p);
+    }
+
+  uint32 keys[Lookup_keys];
+  for (uint32 & key : keys)
+    {
+    key = elems[random.RandHelper(table_length)]->m_id;
+    }
+
+  uint32 thousands = table_length / 1000u;
+
+  run_workload(FString::Printf(TEXT("lookup_sorted_%uk"), thousands), 1000000u, [&sorted, &keys](uint32 count)
+    {
+    uint32 found_count = 0u;
+    for (uint32 idx = 0u; idx < count; ++idx)
+      {
+      found_count += sorted.find(keys[idx & (Lookup_keys - 1u)]);
+      }
+    s_lookup_sink = found_count;
+    });
+  }
+
+//---------------------------------------------------------------------------------------
+// Times loading a batch of elements in sorted order into a sorted table that already
+// has elements interleaved with them - like merging a symbol table binary - with one
+// insert per element versus a single merge with APSorted::append_all()
+void USkookumScriptBenchmarkCommandlet::run_load_workloads(uint32 load_length)
+  {
+  TArray<BenchKeyed>                    existing;
+  TArray<BenchKeyed>                    loaded;
+  TArray<const BenchKeyed *>            loaded_ptrs;
+  APSortedLogical<BenchKeyed, uint32_t> table;
+
+  // Loaded elements get odd ids and existing ones even ids spread over the same range so
+  // every loaded element lands between existing ones
+  tWorkloadFunc setup_f = [&existing, &loaded, &loaded_ptrs, &table](uint32 count)
+    {
+    uint32 existing_length = FMath::Max(count / uint32(Load_existing_div), 1u);
+
+    table.empty();
+    existing.SetNumZeroed(existing_length);
+    loaded.SetNumZeroed(count);
+    loaded_ptrs.SetNumUninitialized(count);
+
+    for (uint32 idx = 0u; idx < existing_length; ++idx)
+      {
+      existing[idx].m_id = idx * Load_existing_div * 2u;
+      }
+    for (uint32 idx = 0u; idx < count; ++idx)
+      {
+      loaded[idx].m_id = idx * 2u + 1u;
+      loaded_ptrs[idx] = &loaded[idx];
+      }
+
+    // Room for everything up front like ASymbolTable::merge_binary() so only the
+    // inserting and merging is timed
+    table.ensure_size(existing_length + count);
+    for (const BenchKeyed & elem : existing)
+      {
+      table.append(elem);
+      }
+    };
+
+  uint32 thousands = load_length / 1000u;
+
+  run_workload(FString::Printf(TEXT("load_insert_%uk"), thousands), load_length, [&loaded, &table](uint32 count)
+    {
+    for (const BenchKeyed & elem : loaded)
+      {
+      table.append(elem);
+      }
+    },
+    setup_f);
+
+  run_workload(FString::Printf(TEXT("load_merge_%uk"), thousands), load_length, [&loaded_ptrs, &table](uint32 count)
+    {
+    table.append_all(loaded_ptrs.GetData(), uint32(loaded_ptrs.Num()), true);
+    },
+    setup_f);
+
+  table.empty();
+  }
+
+//---------------------------------------------------------------------------------------
+// Creates a game world - which also starts SkookumScript gameplay - and populates it
+// with actors
+//
+// #Returns: true if the script workloads can run
+bool USkookumScriptBenchmarkCommandlet::setup_world()
+  {
+  m_world_p = UWorld::CreateWorld(EWorldType::Game, false, TEXT("SkookumScriptBenchmark"));
+  GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(m_world_p);
+  m_world_p->InitializeActorsForPlay(FURL());
+  m_world_p->BeginPlay();
+
+  for (int32 idx = 0; idx < Actor_count; ++idx)
+    {
+    FActorSpawnParameters spawn_params;
+    spawn_params.Name = *FString::Printf(TEXT("SkBenchActor%d"), idx);
+    m_actors.Add(m_world_p->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, spawn_params));
+    }
+
+  if (SkookumScript::get_initialization_level() < SkookumScript::InitializationLevel_gameplay || !SkookumScript::get_master_mind())
+    {
+    UE_LOG(LogSkookum, Error, TEXT("SkookumScript gameplay could not be started in the benchmark world."));
+    return false;
+    }
+
+  m_benchmark_class_p = SkBrain::get_class("SkookumBenchmark");
+  if (!m_benchmark_class_p)
+    {
+    UE_LOG(LogSkookum, Error, TEXT("Class 'SkookumBenchmark' not found - enable the Benchmark overlay in the Skookum project settings and recompile the binaries."));
+    return false;
+    }
+
+  // Let startup scripts get going so they do not end up in the timings
+  tick_world();
+
+  return true;
+  }
+
+//---------------------------------------------------------------------------------------
+// Destroys the game world - which also ends SkookumScript gameplay
+void USkookumScriptBenchmarkCommandlet::teardown_world()
+  {
+  m_actors.Reset();
+  m_benchmark_class_p = nullptr;
+
+  if (m_world_p)
+    {
+    GEngine->DestroyWorldContext(m_world_p);
+    m_world_p->DestroyWorld(false);
+    m_world_p = nullptr;
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Runs one frame of the benchmark world including the SkookumScript update
+void USkookumScriptBenchmarkCommandlet::tick_world()
+  {
+  m_world_p->Tick(LEVELTICK_All, Frame_delta);
+  GFrameCounter++;
+  }
+
+//---------------------------------------------------------------------------------------
+// Writes all results as JSON
+//
+// #Returns: true if written
+bool USkookumScriptBenchmarkCommandlet::write_results(const FString & file_path) const
+  {
+  TSharedRef<FJsonObject> root_p = MakeShareable(new FJsonObject);
+  TArray<TSharedPtr<FJsonValue>> workloads;
+
+  for (const Result & result : m_results)
+    {
+    TSharedRef<FJsonObject> workload_p = MakeShareable(new FJsonObject);
+    workload_p->SetStringField(TEXT("Name"), result.m_name);
+    workload_p->SetNumberField(TEXT("Iterations"), result.m_iterations);
+    workload_p->SetNumberField(TEXT("Milliseconds"), result.m_msecs);
+    workload_p->SetNumberField(TEXT("NsPerIteration"), result.get_nsecs_per_iteration());
+    workloads.Add(MakeShareable(new FJsonValueObject(workload_p)));
+    }
+
+  root_p->SetNumberField(TEXT("Version"), Benchmark_version);
+  root_p->SetNumberField(TEXT("Scale"), m_scale);
+  root_p->SetArrayField(TEXT("Workloads"), workloads);
+
+  FString json_str;
+  TSharedRef<TJsonWriter<>> writer_p = TJsonWriterFactory<>::Create(&json_str);
+  FJsonSerializer::Serialize(root_p, writer_p);
+
+  if (!FFileHelper::SaveStringToFile(json_str, *file_path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+    UE_LOG(LogSkookum, Error, TEXT("Could not write SkookumScript benchmark results '%s'."), *file_path);
+    return false;
+    }
+
+  UE_LOG(LogSkookum, Display, TEXT("SkookumScript benchmark results written to '%s'."), *file_path);
+
+  return true;
+  }
+
+//---------------------------------------------------------------------------------------
+// Compares the time per iteration of each workload with a baseline written by an
+// earlier run
+//
+// #Params:
+//   file_path: baseline JSON file
+//   tolerance: fraction a workload may be slower than its baseline
+//
+// #Returns:
+//   false if a workload is slower than the tolerance allows or if the baseline is missing
+//   or does not cover every workload - a run that could not be compared must not pass
+//   as a gate
+bool USkookumScriptBenchmarkCommandlet::compare_to_baseline(const FString & file_path, float tolerance) const
+  {
+  FString json_str;
+  if (!FFileHelper::LoadFileToString(json_str, *file_path))
+    {
+    UE_LOG(LogSkookum, Error, TEXT("No SkookumScript benchmark baseline '%s' - record one on the reference machine with -UpdateBaseline or run without -Gated/-Baseline."), *file_path);
+    return false;
+    }
+
+  TSharedPtr<FJsonObject> root_p;
+  TSharedRef<TJsonReader<>> reader_p = TJsonReaderFactory<>::Create(json_str);
+  if (!FJsonSerializer::Deserialize(reader_p, root_p) || !root_p.IsValid())
+    {
+    UE_LOG(LogSkookum, Error, TEXT("Could not parse SkookumScript benchmark baseline '%s'."), *file_path);
+    return false;
+    }
+
+  if (int32(root_p->GetNumberField(TEXT("Version"))) != Benchmark_version)
+    {
+    UE_LOG(LogSkookum, Error, TEXT("SkookumScript benchmark baseline '%s' is from a different version of the workloads - record it again with -UpdateBaseline."), *file_path);
+    return false;
+    }
+
+  TMap<FString, double> baseline_nsecs;
+  for (const TSharedPtr<FJsonValue> & value_p : root_p->GetArrayField(TEXT("Workloads")))
+    {
+    const TSharedPtr<FJsonObject> & workload_p = value_p->AsObject();
+    baseline_nsecs.Add(workload_p->GetStringField(TEXT("Name")), workload_p->GetNumberField(TEXT("NsPerIteration")));
+    }
+
+  bool passed_b = true;
+  for (const Result & result : m_results)
+    {
+    const double * nsecs_p = baseline_nsecs.Find(result.m_name);
+    if (!nsecs_p || *nsecs_p <= 0.0)
+      {
+      UE_LOG(LogSkookum, Error, TEXT("Benchmark '%s' has no time in baseline '%s' - record it again with -UpdateBaseline."), *result.m_name, *file_path);
+      passed_b = false;
+      }
+    else
+      {
+      double ratio = result.get_nsecs_per_iteration() / *nsecs_p;
+      if (ratio > 1.0 + tolerance)
+        {
+        UE_LOG(LogSkookum, Error, TEXT("Benchmark '%s' regressed: %.1f ns/iteration vs. %.1f in baseline (+%.0f%%)."), *result.m_name, result.get_nsecs_per_iteration(), *nsecs_p, (ratio - 1.0) * 100.0);
+        passed_b = false;
+        }
+      }
+    }
+
+  if (passed_b)
+    {
+    UE_LOG(LogSkookum, Display, TEXT("SkookumScript benchmarks are within %.0f%% of baseline '%s'."), tolerance * 100.0f, *file_path);
+    }
+
+  return passed_b;
+  }
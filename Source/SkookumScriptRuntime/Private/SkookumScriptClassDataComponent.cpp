@@ -15,6 +15,8 @@
 
 #include "SkookumScriptClassDataComponent.h"
 #include "Bindings/Engine/SkUEActor.hpp"
+#include "Bindings/SkUERuntime.hpp"
+#include "Bindings/SkUEProfiler.hpp"
 
 //=======================================================================================
 // Class Data
@@ -104,7 +106,7 @@ void USkookumScriptClassDataComponent::delete_sk_instance()
   {
   SK_ASSERTX(m_actor_instance_p, "No Sk instance to delete!");
   m_actor_instance_p->clear_coroutines();
-  m_actor_instance_p->dereference();
+  SkUERuntime::get_singleton()->dereference_deferred(m_actor_instance_p);
   m_actor_instance_p = nullptr;
   }
 
@@ -128,6 +130,8 @@ void USkookumScriptClassDataComponent::InitializeComponent()
 
     create_sk_instance();
     m_actor_instance_p->get_class()->resolve_raw_data();
+
+    SKUE_PROFILE_SCOPE(m_actor_instance_p->get_class()->get_name(), ASymbolX_ctor);
     m_actor_instance_p->call_default_constructor();
     }
   }
@@ -2,7 +2,7 @@
 // SkookumScript Plugin for Unreal Engine 4
 // Copyright (c) 2015 Agog Labs Inc. All rights reserved.
 //
-// UObject that listens to dynamic multicast delegate events
+// Listeners to dynamic and native multicast delegate events
 // 
 // Author: Markus Breyer
 //=======================================================================================
@@ -16,13 +16,27 @@
 #include "SkookumScriptListenerManager.hpp"
 
 #include "Bindings/VectorMath/SkVector3.hpp"
+#include "Bindings/Engine/SkUEEventFilter.hpp"
+#include "Bindings/Engine/SkUEEventQueuePolicy.hpp"
 #include "Bindings/Engine/SkUEName.hpp"
+#include "Bindings/SkUEProfiler.hpp"
 
 #include <SkUEEntity.generated.hpp>
 
 #include <SkookumScript/SkBoolean.hpp>
 #include <SkookumScript/SkClosure.hpp>
+#include <SkookumScript/SkInteger.hpp>
+#include <SkookumScript/SkInvokableBase.hpp>
 #include <SkookumScript/SkInvokedCoroutine.hpp>
+#include <SkookumScript/SkReal.hpp>
+
+#include "Stats.h"
+
+//=======================================================================================
+// Local Global Data
+//=======================================================================================
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("SkookumScript Dropped Events"), STAT_SkookumScriptDroppedEvents, STATGROUP_Game);
 
 //=======================================================================================
 // FSkookumScriptListenerAutoPtr
@@ -36,57 +50,103 @@ FSkookumScriptListenerAutoPtr::~FSkookumScriptListenerAutoPtr()
   }
 
 //=======================================================================================
-// Class Data
+// FSkookumScriptNativeListenerAutoPtr
+//======================================================================================
+
+FSkookumScriptNativeListenerAutoPtr::~FSkookumScriptNativeListenerAutoPtr()
+  {
+  SkookumScriptListenerManager::get_singleton()->free_native_listener(m_listener_p);
+  }
+
+//=======================================================================================
+// FSkookumScriptEventFilter
 //=======================================================================================
 
+//---------------------------------------------------------------------------------------
+// Tests an argument that has already been boxed
+bool FSkookumScriptEventFilter::test_instance(SkInstance * arg_p)
+  {
+  SkClass * class_p = arg_p->get_class();
+  if (class_p->is_class(*SkUEEntity::get_class()))
+    {
+    return test_object(arg_p->as<SkUEEntity>());
+    }
+  if (class_p->is_class(*SkBrain::ms_real_class_p))
+    {
+    return test_scalar(arg_p->as<SkReal>());
+    }
+  if (class_p->is_class(*SkBrain::ms_integer_class_p))
+    {
+    return test_scalar(float(arg_p->as<SkInteger>()));
+    }
+  if (class_p->is_class(*SkVector3::get_class()))
+    {
+    return test_vector(arg_p->as<SkVector3>());
+    }
+  return test_unsupported();
+  }
+
+//---------------------------------------------------------------------------------------
+// Called when the tested argument has a type the filter cannot test - complains once and
+// then lets all events pass
+bool FSkookumScriptEventFilter::test_unsupported()
+  {
+  SK_ERRORX(a_str_format("Event filter cannot test argument %u of this event - it will be ignored.", m_arg_idx));
+  m_kind = Kind_none;
+  return true;
+  }
+
 //=======================================================================================
-// Method Definitions
+// SkookumScriptListenerBase
 //=======================================================================================
 
 //---------------------------------------------------------------------------------------
 
-USkookumScriptListener::USkookumScriptListener(const FObjectInitializer& ObjectInitializer)
-  : Super(ObjectInitializer)
+SkookumScriptListenerBase::SkookumScriptListenerBase()
+  : m_event_count(0)
   , m_num_arguments(0)
-  , m_unregister_callback_p(nullptr)
+  , m_payload_size(0)
+  , m_payload_first(0)
+  , m_payload_count(0)
+  , m_unpack_payload_f(nullptr)
+  , m_payload_key_f(nullptr)
+  , m_dropped_count(0)
   {
   }
 
 //---------------------------------------------------------------------------------------
 
-void USkookumScriptListener::initialize(UObject * obj_p, SkInvokedCoroutine * coro_p, tUnregisterCallback callback_p)
+void SkookumScriptListenerBase::initialize_events(SkInvokedCoroutine * coro_p)
   {
   SK_ASSERTX(!coro_p->is_suspended(), "Coroutine must not be suspended yet when delegate object is initialized.");
 
-  m_obj_p = obj_p;
   m_coro_p = coro_p;
-  m_unregister_callback_p = callback_p;
   m_num_arguments = 0;
+  m_filter = FSkookumScriptEventFilter();
+  m_queue_policy = FSkookumScriptEventQueuePolicy();
+  m_dropped_count = 0;
   }
 
 //---------------------------------------------------------------------------------------
 
-void USkookumScriptListener::deinitialize()
+void SkookumScriptListenerBase::deinitialize_events()
   {
   // Kill any events that are still around
-  while (has_event())
+  discard_events();
+
+  // Don't let a spike of events tie up memory while pooled
+  if (m_payload_buffer.Num() > Payload_keep_bytes)
     {
-    free_event(pop_event(), true);
+    m_payload_buffer.Empty();
     }
 
   // Forget the coroutine we keep track of
   m_coro_p.null();
-
-  // Unregister from delegate list if any
-  if (m_unregister_callback_p && m_obj_p.IsValid())
-    {
-    (*m_unregister_callback_p)(m_obj_p.Get(), this);
-    }
   }
 
 //---------------------------------------------------------------------------------------
 
-USkookumScriptListener::EventInfo * USkookumScriptListener::alloc_event()
+SkookumScriptListenerBase::EventInfo * SkookumScriptListenerBase::alloc_event()
   {
   EventInfo * event_p = SkookumScriptListenerManager::get_singleton()->alloc_event();
   #if (SKOOKUM & SK_DEBUG)
@@ -96,15 +156,57 @@ USkookumScriptListener::EventInfo * USkookumScriptListener::alloc_event()
   }
 
 //---------------------------------------------------------------------------------------
+// Returns the oldest queued event - raw payloads are boxed into arguments at this point
+SkookumScriptListenerBase::EventInfo * SkookumScriptListenerBase::pop_event()
+  {
+  if (!m_event_queue.is_empty())
+    {
+    m_event_count--;
+    return m_event_queue.pop_first();
+    }
+
+  SK_ASSERTX(m_payload_count, "Must have an event to pop.");
+  EventInfo * event_p = alloc_event();
+  // Take payload out of the ring first since the closure may cause more events
+  void * payload_p = get_payload(m_payload_first);
+  m_payload_first = (m_payload_count > 1u) ? (m_payload_first + 1u) % (m_payload_buffer.Num() / m_payload_size) : 0u;
+  m_payload_count--;
+  (*m_unpack_payload_f)(payload_p, event_p->m_argument_p);
+  return event_p;
+  }
 
-void USkookumScriptListener::free_event(EventInfo * event_p, bool free_arguments)
+//---------------------------------------------------------------------------------------
+
+void SkookumScriptListenerBase::free_event(EventInfo * event_p, bool free_arguments)
   {
   SkookumScriptListenerManager::get_singleton()->free_event(event_p, free_arguments ? m_num_arguments : 0);
   }
 
 //---------------------------------------------------------------------------------------
+// Throws away all queued events - raw payloads are destructed without being boxed
+void SkookumScriptListenerBase::discard_events()
+  {
+  while (!m_event_queue.is_empty())
+    {
+    free_event(m_event_queue.pop_first(), true);
+    }
+  m_event_count = 0u;
 
-void USkookumScriptListener::push_event_and_resume(EventInfo * event_p, uint32_t num_arguments)
+  if (m_payload_count)
+    {
+    uint32_t capacity = m_payload_buffer.Num() / m_payload_size;
+    for (; m_payload_count; --m_payload_count)
+      {
+      (*m_unpack_payload_f)(get_payload(m_payload_first), nullptr);
+      m_payload_first = (m_payload_first + 1u) % capacity;
+      }
+    }
+  m_payload_first = 0u;
+  }
+
+//---------------------------------------------------------------------------------------
+
+void SkookumScriptListenerBase::push_event_and_resume(EventInfo * event_p, uint32_t num_arguments)
   {
   #if (SKOOKUM & SK_DEBUG)
     for (uint32_t i = 0; i < num_arguments; ++i) SK_ASSERTX(event_p->m_argument_p[i], "All event arguments must be set.");
@@ -112,33 +214,301 @@ void USkookumScriptListener::push_event_and_resume(EventInfo * event_p, uint32_t
     SK_ASSERTX(m_num_arguments == 0 || m_num_arguments == num_arguments, "All events must have same argument count.");
   #endif
   m_num_arguments = num_arguments;
+
+  // Drop event right away if it does not pass the filter
+  if (m_filter.is_active()
+    && (m_filter.get_arg_idx() >= num_arguments ? !m_filter.test_unsupported() : !m_filter.test_instance(event_p->m_argument_p[m_filter.get_arg_idx()])))
+    {
+    free_event(event_p, true);
+    return;
+    }
+
+  // Coalesce with queued events
+  switch (m_queue_policy.m_kind)
+    {
+    case FSkookumScriptEventQueuePolicy::Kind_keep_first:
+    case FSkookumScriptEventQueuePolicy::Kind_wait_first:
+      if (has_event())
+        {
+        free_event(event_p, true);
+        // Later events are of no interest to a wait coroutine so they are no overflow
+        if (m_queue_policy.m_kind == FSkookumScriptEventQueuePolicy::Kind_keep_first)
+          {
+          m_dropped_count++;
+          INC_DWORD_STAT(STAT_SkookumScriptDroppedEvents);
+          }
+        return;
+        }
+      break;
+
+    case FSkookumScriptEventQueuePolicy::Kind_keep_latest:
+      while (has_event())
+        {
+        drop_oldest_event();
+        }
+      break;
+
+    case FSkookumScriptEventQueuePolicy::Kind_dedupe:
+      if (dedupe_event(event_p->m_argument_p))
+        {
+        // Arguments moved to the queued event which already resumed the coroutine
+        free_event(event_p, false);
+        return;
+        }
+      break;
+
+    default:
+      break;
+    }
+
   m_event_queue.append(event_p);
+  m_event_count++;
+  if (m_queue_policy.m_max_count && m_event_count + m_payload_count > m_queue_policy.m_max_count)
+    {
+    drop_oldest_event();
+    }
+  if (m_coro_p.is_valid()) m_coro_p->resume();
+  }
+
+//---------------------------------------------------------------------------------------
+// Returns memory for the next raw event payload which the caller must construct in place
+// and then queue with push_payload_and_resume()
+//
+// Params:
+//   payload_size: sizeof() the payload type - a multiple of its alignment
+//   num_arguments: number of arguments the payload is boxed into
+//   unpack_f: boxes and destructs a payload of this type
+//   key_f: gets a key argument of a payload of this type - only needed for
+//     FSkookumScriptEventQueuePolicy::Kind_dedupe
+void * SkookumScriptListenerBase::alloc_payload(uint32_t payload_size, uint32_t num_arguments, tUnpackPayload unpack_f, tPayloadKey key_f)
+  {
+  SK_ASSERTX(payload_size > 0u, "Event payloads cannot be empty.");
+  SK_ASSERTX(m_payload_count == 0u || (payload_size == m_payload_size && unpack_f == m_unpack_payload_f), "All events must have same payload type.");
+  SK_ASSERTX(m_num_arguments == 0 || m_num_arguments == num_arguments, "All events must have same argument count.");
+
+  m_payload_size     = payload_size;
+  m_unpack_payload_f = unpack_f;
+  m_payload_key_f    = key_f;
+  m_num_arguments    = num_arguments;
+
+  uint32_t capacity = m_payload_buffer.Num() / m_payload_size;
+  if (m_payload_count >= capacity)
+    {
+    grow_payload_buffer();
+    capacity = m_payload_buffer.Num() / m_payload_size;
+    }
+
+  return get_payload((m_payload_first + m_payload_count) % capacity);
+  }
+
+//---------------------------------------------------------------------------------------
+// Queues the payload constructed in the memory returned by alloc_payload()
+void SkookumScriptListenerBase::push_payload_and_resume()
+  {
+  // Coalesce with queued events
+  switch (m_queue_policy.m_kind)
+    {
+    case FSkookumScriptEventQueuePolicy::Kind_keep_first:
+    case FSkookumScriptEventQueuePolicy::Kind_wait_first:
+      if (has_event())
+        {
+        (*m_unpack_payload_f)(get_payload((m_payload_first + m_payload_count) % (m_payload_buffer.Num() / m_payload_size)), nullptr);
+        if (m_queue_policy.m_kind == FSkookumScriptEventQueuePolicy::Kind_keep_first)
+          {
+          m_dropped_count++;
+          INC_DWORD_STAT(STAT_SkookumScriptDroppedEvents);
+          }
+        return;
+        }
+      break;
+
+    case FSkookumScriptEventQueuePolicy::Kind_keep_latest:
+      // The new payload ends up as the first one
+      while (has_event())
+        {
+        drop_oldest_event();
+        }
+      break;
+
+    case FSkookumScriptEventQueuePolicy::Kind_dedupe:
+      if (dedupe_payload())
+        {
+        // Queued event already resumed the coroutine
+        return;
+        }
+      break;
+
+    default:
+      break;
+    }
+
+  m_payload_count++;
+  if (m_queue_policy.m_max_count && m_event_count + m_payload_count > m_queue_policy.m_max_count)
+    {
+    drop_oldest_event();
+    }
   if (m_coro_p.is_valid()) m_coro_p->resume();
   }
 
 //---------------------------------------------------------------------------------------
+// Throws away the oldest queued event without boxing it
+void SkookumScriptListenerBase::drop_oldest_event()
+  {
+  if (!m_event_queue.is_empty())
+    {
+    free_event(m_event_queue.pop_first(), true);
+    m_event_count--;
+    }
+  else
+    {
+    (*m_unpack_payload_f)(get_payload(m_payload_first), nullptr);
+    m_payload_first = (m_payload_first + 1u) % (m_payload_buffer.Num() / m_payload_size);
+    m_payload_count--;
+    }
 
-bool USkookumScriptListener::coro_on_event_do(SkInvokedCoroutine * scope_p, tRegisterCallback register_f, tUnregisterCallback unregister_f, bool do_until)
+  m_dropped_count++;
+  INC_DWORD_STAT(STAT_SkookumScriptDroppedEvents);
+  }
+
+//---------------------------------------------------------------------------------------
+// Gives the new arguments to a queued event with the same key argument if any
+//
+// Returns: true if the arguments were taken over by a queued event
+bool SkookumScriptListenerBase::dedupe_event(SkInstance ** args_pp)
   {
-  UObject * this_p = scope_p->this_as<SkUEEntity>();
+  uint32_t key_idx = m_queue_policy.m_key_arg_idx;
+  uint64 key = (key_idx < m_num_arguments) ? get_instance_key(args_pp[key_idx]) : Key_unsupported;
+  if (key == Key_unsupported)
+    {
+    report_unsupported_key();
+    return false;
+    }
 
-  // Just started?
-  if (scope_p->m_update_count == 0u)
+  for (EventInfo * queued_p = m_event_queue.get_first_null(); queued_p; queued_p = m_event_queue.get_next_null(queued_p))
     {
-    // Install and store away event listener
-    USkookumScriptListener * listener_p = SkookumScriptListenerManager::get_singleton()->alloc_listener(this_p, scope_p, unregister_f);
-    scope_p->append_user_data<FSkookumScriptListenerAutoPtr, USkookumScriptListener *>(listener_p);
-    (*register_f)(this_p, listener_p);
+    if (get_instance_key(queued_p->m_argument_p[key_idx]) == key)
+      {
+      for (uint32_t i = 0; i < m_num_arguments; ++i)
+        {
+        queued_p->m_argument_p[i]->dereference();
+        queued_p->m_argument_p[i] = args_pp[i];
+        }
+      m_dropped_count++;
+      INC_DWORD_STAT(STAT_SkookumScriptDroppedEvents);
+      return true;
+      }
+    }
 
-    // Suspend coroutine
-    scope_p->suspend();
+  return false;
+  }
 
-    // Coroutine not complete yet - call again when resumed
+//---------------------------------------------------------------------------------------
+// Moves the payload just constructed by the caller of alloc_payload() over a queued
+// payload with the same key argument if any
+//
+// Returns: true if a queued payload was replaced
+bool SkookumScriptListenerBase::dedupe_payload()
+  {
+  uint32_t capacity  = m_payload_buffer.Num() / m_payload_size;
+  uint32_t key_idx   = m_queue_policy.m_key_arg_idx;
+  void *   new_p     = get_payload((m_payload_first + m_payload_count) % capacity);
+  uint64   key       = m_payload_key_f ? (*m_payload_key_f)(new_p, key_idx) : Key_unsupported;
+  if (key == Key_unsupported)
+    {
+    report_unsupported_key();
     return false;
     }
 
-  // Get back stored event listener
-  USkookumScriptListener * listener_p = scope_p->get_user_data<FSkookumScriptListenerAutoPtr>()->Get();
+  for (uint32_t i = 0u; i < m_payload_count; ++i)
+    {
+    void * queued_p = get_payload((m_payload_first + i) % capacity);
+    if ((*m_payload_key_f)(queued_p, key_idx) == key)
+      {
+      (*m_unpack_payload_f)(queued_p, nullptr);
+      FMemory::Memcpy(queued_p, new_p, m_payload_size);
+      m_dropped_count++;
+      INC_DWORD_STAT(STAT_SkookumScriptDroppedEvents);
+      return true;
+      }
+    }
+
+  return false;
+  }
+
+//---------------------------------------------------------------------------------------
+// Called when the key argument of the dedupe policy cannot serve as key - complains once
+// and then queues all events
+void SkookumScriptListenerBase::report_unsupported_key()
+  {
+  SK_ERRORX(a_str_format("Event argument %u cannot be used as dedupe key - all events will be queued.", m_queue_policy.m_key_arg_idx));
+  m_queue_policy.m_kind = FSkookumScriptEventQueuePolicy::Kind_keep_all;
+  }
+
+//---------------------------------------------------------------------------------------
+// Gets a boxed argument as key for FSkookumScriptEventQueuePolicy::Kind_dedupe
+uint64 SkookumScriptListenerBase::get_instance_key(SkInstance * arg_p)
+  {
+  SkClass * class_p = arg_p->get_class();
+  if (class_p->is_class(*SkUEEntity::get_class()))
+    {
+    return uint64(UPTRINT(arg_p->as<SkUEEntity>().get_obj()));
+    }
+  if (class_p->is_class(*SkBrain::ms_integer_class_p))
+    {
+    return uint64(arg_p->as<SkInteger>());
+    }
+  if (class_p->is_class(*SkUEName::get_class()))
+    {
+    const FName & name = arg_p->as<SkUEName>();
+    return (uint64(uint32(name.GetComparisonIndex())) << 32u) | uint32(name.GetNumber());
+    }
+  return Key_unsupported;
+  }
+
+//---------------------------------------------------------------------------------------
+// Doubles the payload capacity and moves the queued payloads to the start of the new
+// buffer - payloads are moved bitwise like all UE4 container elements
+void SkookumScriptListenerBase::grow_payload_buffer()
+  {
+  uint32_t old_capacity = m_payload_buffer.Num() / m_payload_size;
+  uint32_t new_capacity = FMath::Max<uint32_t>(old_capacity * 2u, Payload_init_capacity);
+
+  TArray<uint8, TAlignedHeapAllocator<Payload_alignment>> new_buffer;
+  new_buffer.AddUninitialized(new_capacity * m_payload_size);
+  if (m_payload_count)
+    {
+    uint32_t first_count = FMath::Min(m_payload_count, old_capacity - m_payload_first);
+    FMemory::Memcpy(new_buffer.GetData(), get_payload(m_payload_first), first_count * m_payload_size);
+    FMemory::Memcpy(new_buffer.GetData() + first_count * m_payload_size, m_payload_buffer.GetData(), (m_payload_count - first_count) * m_payload_size);
+    }
+  m_payload_buffer = MoveTemp(new_buffer);
+  m_payload_first = 0u;
+  }
+
+//---------------------------------------------------------------------------------------
+// Hands the optional event filter and queue policy arguments of `_on_x_do()` and
+// `_on_x_do_until()` to the listener
+void SkookumScriptListenerBase::set_event_args(SkInvokedCoroutine * scope_p, SkookumScriptListenerBase * listener_p)
+  {
+  SkInstance * filter_p = scope_p->get_arg(SkArg_2);
+  if (filter_p != SkBrain::ms_nil_p)
+    {
+    listener_p->set_filter(filter_p->as<SkUEEventFilter>());
+    }
+
+  SkInstance * policy_p = scope_p->get_arg(SkArg_3);
+  if (policy_p != SkBrain::ms_nil_p)
+    {
+    listener_p->set_queue_policy(policy_p->as<SkUEEventQueuePolicy>());
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Runs the closure of `_on_x_do()` or `_on_x_do_until()` on each queued event
+//
+// Returns: true if the coroutine is done
+bool SkookumScriptListenerBase::run_event_closure(SkInvokedCoroutine * scope_p, SkookumScriptListenerBase * listener_p, bool do_until)
+  {
   SK_ASSERTX(listener_p->has_event(), "Must have event at this point as coroutine was resumed by delegate object.");
 
   // Run closure on each event accumulated in the listener
@@ -150,7 +520,7 @@ bool USkookumScriptListener::coro_on_event_do(SkInvokedCoroutine * scope_p, tReg
   do
     {
     // Use event parameters to invoke closure, then recycle event
-    USkookumScriptListener::EventInfo * event_p = listener_p->pop_event();
+    EventInfo * event_p = listener_p->pop_event();
     if (do_until)
       {
       // Add reference to potential return values so they survive closure_method_call 
@@ -167,7 +537,7 @@ bool USkookumScriptListener::coro_on_event_do(SkInvokedCoroutine * scope_p, tReg
         {
         for (uint32_t i = 0; i < num_arguments; ++i)
           {
-          scope_p->set_arg(SkArg_2 + i, event_p->m_argument_p[i]); // Store parameters as return values if exiting
+          scope_p->set_arg(SkArg_4 + i, event_p->m_argument_p[i]); // Store parameters as return values if exiting
           }
         }
       else
@@ -193,18 +563,94 @@ bool USkookumScriptListener::coro_on_event_do(SkInvokedCoroutine * scope_p, tReg
     return true;
   }
 
+//---------------------------------------------------------------------------------------
+// Returns the first queued event from `_wait_x()`
+//
+// Returns: true since the coroutine is done
+bool SkookumScriptListenerBase::return_first_event(SkInvokedCoroutine * scope_p, SkookumScriptListenerBase * listener_p)
+  {
+  SK_ASSERTX(listener_p->has_event(), "Must have event at this point as coroutine was resumed by delegate object.");
+
+  // Return first event queued up on listener
+  // and *DISCARD* potential other events without ever boxing their arguments
+  uint32_t num_arguments = listener_p->get_num_arguments();
+  EventInfo * event_p = listener_p->pop_event();
+  for (uint32_t i = 0; i < num_arguments; ++i)
+    {
+    scope_p->set_arg(SkArg_1 + i, event_p->m_argument_p[i]); // Store parameters as return values if exiting
+    }
+  listener_p->free_event(event_p, false);
+  listener_p->discard_events();
+
+  // Ok done, return event parameters and quit
+  return true;
+  }
+
+//=======================================================================================
+// USkookumScriptListener
+//=======================================================================================
+
 //---------------------------------------------------------------------------------------
 
-bool USkookumScriptListener::coro_wait_event(SkInvokedCoroutine * scope_p, tUnregisterCallback register_f, tUnregisterCallback unregister_f)
+USkookumScriptListener::USkookumScriptListener(const FObjectInitializer& ObjectInitializer)
+  : Super(ObjectInitializer)
+  , m_unregister_callback_p(nullptr)
+  , m_slot_idx(Slot_idx_none)
+  , m_dispatch_obj_p(nullptr)
   {
-  UObject * this_p = scope_p->this_as<SkUEEntity>();
+  }
+
+//---------------------------------------------------------------------------------------
+
+void USkookumScriptListener::initialize(UObject * obj_p, SkInvokedCoroutine * coro_p, tUnregisterCallback callback_p)
+  {
+  initialize_events(coro_p);
+  m_obj_p = obj_p;
+  m_unregister_callback_p = callback_p;
+  }
+
+//---------------------------------------------------------------------------------------
+// Sets up the listener as dispatcher to native listeners - it has no coroutine and no
+// events of its own
+void USkookumScriptListener::initialize_dispatcher(UObject * obj_p, FName delegate_name, tUnregisterCallback callback_p)
+  {
+  m_obj_p = obj_p;
+  m_unregister_callback_p = callback_p;
+  m_dispatch_obj_p = obj_p;
+  m_dispatch_name = delegate_name;
+  }
+
+//---------------------------------------------------------------------------------------
+
+void USkookumScriptListener::deinitialize()
+  {
+  deinitialize_events();
+
+  // Unregister from delegate list if any
+  if (m_unregister_callback_p && m_obj_p.IsValid())
+    {
+    (*m_unregister_callback_p)(m_obj_p.Get(), this);
+    }
+
+  SK_ASSERTX(m_native_listeners.Num() == 0, "Dispatcher must not have native listeners left when freed.");
+  m_dispatch_obj_p = nullptr;
+  m_dispatch_name = NAME_None;
+  }
+
+//---------------------------------------------------------------------------------------
+
+bool USkookumScriptListener::coro_on_event_do(SkInvokedCoroutine * scope_p, tRegisterCallback register_f, tUnregisterCallback unregister_f, bool do_until)
+  {
+  SKUE_PROFILE_SCOPE(scope_p->get_invokable()->get_scope()->get_name(), scope_p->get_invokable()->get_name());
 
   // Just started?
   if (scope_p->m_update_count == 0u)
     {
     // Install and store away event listener
+    UObject * this_p = scope_p->this_as<SkUEEntity>();
     USkookumScriptListener * listener_p = SkookumScriptListenerManager::get_singleton()->alloc_listener(this_p, scope_p, unregister_f);
     scope_p->append_user_data<FSkookumScriptListenerAutoPtr, USkookumScriptListener *>(listener_p);
+    set_event_args(scope_p, listener_p);
     (*register_f)(this_p, listener_p);
 
     // Suspend coroutine
@@ -215,23 +661,34 @@ bool USkookumScriptListener::coro_wait_event(SkInvokedCoroutine * scope_p, tUnre
     }
 
   // Get back stored event listener
-  USkookumScriptListener * listener_p = scope_p->get_user_data<FSkookumScriptListenerAutoPtr>()->Get();
-  SK_ASSERTX(listener_p->has_event(), "Must have event at this point as coroutine was resumed by delegate object.");
+  return run_event_closure(scope_p, scope_p->get_user_data<FSkookumScriptListenerAutoPtr>()->Get(), do_until);
+  }
 
-  // Return first event queued up on listener
-  // and *DISCARD* potential other events
-  SkClosure * closure_p = scope_p->get_arg_data<SkClosure>(SkArg_1);
-  uint32_t num_arguments = listener_p->get_num_arguments();
-  bool exit = false;
-  USkookumScriptListener::EventInfo * event_p = listener_p->pop_event();
-  for (uint32_t i = 0; i < num_arguments; ++i)
+//---------------------------------------------------------------------------------------
+
+bool USkookumScriptListener::coro_wait_event(SkInvokedCoroutine * scope_p, tRegisterCallback register_f, tUnregisterCallback unregister_f)
+  {
+  SKUE_PROFILE_SCOPE(scope_p->get_invokable()->get_scope()->get_name(), scope_p->get_invokable()->get_name());
+
+  // Just started?
+  if (scope_p->m_update_count == 0u)
     {
-    scope_p->set_arg(SkArg_1 + i, event_p->m_argument_p[i]); // Store parameters as return values if exiting
+    // Install and store away event listener
+    UObject * this_p = scope_p->this_as<SkUEEntity>();
+    USkookumScriptListener * listener_p = SkookumScriptListenerManager::get_singleton()->alloc_listener(this_p, scope_p, unregister_f);
+    scope_p->append_user_data<FSkookumScriptListenerAutoPtr, USkookumScriptListener *>(listener_p);
+    listener_p->set_queue_policy(FSkookumScriptEventQueuePolicy::Kind_wait_first); // Only the first event is returned
+    (*register_f)(this_p, listener_p);
+
+    // Suspend coroutine
+    scope_p->suspend();
+
+    // Coroutine not complete yet - call again when resumed
+    return false;
     }
-  listener_p->free_event(event_p, false);
 
-  // Ok done, return event parameters and quit
-  return true;
+  // Get back stored event listener
+  return return_first_event(scope_p, scope_p->get_user_data<FSkookumScriptListenerAutoPtr>()->Get());
   }
 
 //---------------------------------------------------------------------------------------
@@ -269,6 +726,15 @@ void USkookumScriptListener::add_dynamic_function(FName callback_name, UClass *
     }
   }
 
+//---------------------------------------------------------------------------------------
+// Hooks up a native listener to the dispatcher of the given delegate of obj_p - the
+// dispatcher is created and registered with register_f for the first listener and
+// unregistered with unregister_f once the last one is freed
+void USkookumScriptListener::add_dispatched_listener(UObject * obj_p, FName delegate_name, SkookumScriptNativeListener * listener_p, tRegisterCallback register_f, tUnregisterCallback unregister_f)
+  {
+  SkookumScriptListenerManager::get_singleton()->add_dispatched_listener(obj_p, delegate_name, listener_p, register_f, unregister_f);
+  }
+
 //---------------------------------------------------------------------------------------
 
 void USkookumScriptListener::remove_dynamic_function(FName callback_name)
@@ -293,3 +759,85 @@ void USkookumScriptListener::remove_dynamic_function(FName callback_name)
     function_p->MarkPendingKill();
     }
   }
+
+//=======================================================================================
+// SkookumScriptNativeListener
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+
+void SkookumScriptNativeListener::initialize(UObject * obj_p, SkInvokedCoroutine * coro_p, tUnregisterCallback callback_p)
+  {
+  initialize_events(coro_p);
+  m_obj_p = obj_p;
+  m_unregister_callback_p = callback_p;
+  }
+
+//---------------------------------------------------------------------------------------
+
+void SkookumScriptNativeListener::deinitialize()
+  {
+  deinitialize_events();
+
+  // Unbind from delegate if any
+  if (m_unregister_callback_p && m_obj_p.IsValid() && m_delegate_handle.IsValid())
+    {
+    (*m_unregister_callback_p)(m_obj_p.Get(), this);
+    }
+  m_delegate_handle.Reset();
+  m_obj_p.Reset();
+  }
+
+//---------------------------------------------------------------------------------------
+
+bool SkookumScriptNativeListener::coro_on_event_do(SkInvokedCoroutine * scope_p, tRegisterCallback register_f, tUnregisterCallback unregister_f, bool do_until)
+  {
+  SKUE_PROFILE_SCOPE(scope_p->get_invokable()->get_scope()->get_name(), scope_p->get_invokable()->get_name());
+
+  // Just started?
+  if (scope_p->m_update_count == 0u)
+    {
+    // Install and store away event listener
+    UObject * this_p = scope_p->this_as<SkUEEntity>();
+    SkookumScriptNativeListener * listener_p = SkookumScriptListenerManager::get_singleton()->alloc_native_listener(this_p, scope_p, unregister_f);
+    scope_p->append_user_data<FSkookumScriptNativeListenerAutoPtr, SkookumScriptNativeListener *>(listener_p);
+    set_event_args(scope_p, listener_p);
+    (*register_f)(this_p, listener_p);
+
+    // Suspend coroutine
+    scope_p->suspend();
+
+    // Coroutine not complete yet - call again when resumed
+    return false;
+    }
+
+  // Get back stored event listener
+  return run_event_closure(scope_p, scope_p->get_user_data<FSkookumScriptNativeListenerAutoPtr>()->Get(), do_until);
+  }
+
+//---------------------------------------------------------------------------------------
+
+bool SkookumScriptNativeListener::coro_wait_event(SkInvokedCoroutine * scope_p, tRegisterCallback register_f, tUnregisterCallback unregister_f)
+  {
+  SKUE_PROFILE_SCOPE(scope_p->get_invokable()->get_scope()->get_name(), scope_p->get_invokable()->get_name());
+
+  // Just started?
+  if (scope_p->m_update_count == 0u)
+    {
+    // Install and store away event listener
+    UObject * this_p = scope_p->this_as<SkUEEntity>();
+    SkookumScriptNativeListener * listener_p = SkookumScriptListenerManager::get_singleton()->alloc_native_listener(this_p, scope_p, unregister_f);
+    scope_p->append_user_data<FSkookumScriptNativeListenerAutoPtr, SkookumScriptNativeListener *>(listener_p);
+    listener_p->set_queue_policy(FSkookumScriptEventQueuePolicy::Kind_wait_first); // Only the first event is returned
+    (*register_f)(this_p, listener_p);
+
+    // Suspend coroutine
+    scope_p->suspend();
+
+    // Coroutine not complete yet - call again when resumed
+    return false;
+    }
+
+  // Get back stored event listener
+  return return_first_event(scope_p, scope_p->get_user_data<FSkookumScriptNativeListenerAutoPtr>()->Get());
+  }
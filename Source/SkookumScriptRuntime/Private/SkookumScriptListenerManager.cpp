@@ -25,36 +25,37 @@ SkookumScriptListenerManager * SkookumScriptListenerManager::get_singleton()
 
 //---------------------------------------------------------------------------------------
 
-SkookumScriptListenerManager::SkookumScriptListenerManager(uint32_t pool_init, uint32_t pool_incr)
-  : m_pool_incr(pool_incr)
-  , m_event_pool(pool_init, pool_incr) // $Revisit MBreyer - use separate settings for delegate objects and events
+SkookumScriptListenerManager::SkookumScriptListenerManager(uint32_t listener_pool_init, uint32_t listener_pool_incr, uint32_t event_pool_init, uint32_t event_pool_incr)
+  : m_pool_incr(listener_pool_incr)
+  , m_listener_keep_idle(listener_pool_init)
+  , m_event_pool(event_pool_init, event_pool_incr)
   {
-  grow_inactive_list(m_pool_incr);
-  m_active_list.ensure_size(pool_init);
+  grow_inactive_list(listener_pool_init);
   }
 
 //---------------------------------------------------------------------------------------
 
 SkookumScriptListenerManager::~SkookumScriptListenerManager()
   {
+  // Unbind native listeners still in use so their delegates do not call into freed
+  // memory - this also frees the dispatchers they are hooked up to
+  while (!m_native_active_list.is_empty())
+    {
+    SkookumScriptNativeListener * listener_p = m_native_active_list.get_last();
+    deactivate_native_listener(listener_p);
+    m_native_inactive_list.append(*listener_p);
+    }
+  SK_ASSERTX(m_dispatchers.Num() == 0, "All dispatchers must be freed along with their native listeners.");
+
   while (!m_active_list.is_empty())
     {
-    USkookumScriptListener * listener_p = m_active_list.pop_last();
-    if (listener_p->IsValidLowLevel())
-      {
-      listener_p->RemoveFromRoot(); // Make listener object garbage collectable
-      listener_p->MarkPendingKill();
-      }
+    release_listener(m_active_list.pop_last());
     }
   while (!m_inactive_list.is_empty())
     {
-    USkookumScriptListener * listener_p = m_inactive_list.pop_last();
-    if (listener_p->IsValidLowLevel())
-      {
-      listener_p->RemoveFromRoot(); // Make listener object garbage collectable
-      listener_p->MarkPendingKill();
-      }
+    release_listener(m_inactive_list.pop_last());
     }
+  m_native_inactive_list.free_all();
   }
 
 //---------------------------------------------------------------------------------------
@@ -67,16 +68,26 @@ USkookumScriptListener * SkookumScriptListenerManager::alloc_listener(UObject *
     }
   USkookumScriptListener * delegate_obj = m_inactive_list.pop_last();
   delegate_obj->initialize(obj_p, coro_p, callback_p);
+  delegate_obj->m_slot_idx = m_active_list.get_length();
   m_active_list.append(*delegate_obj);
   return delegate_obj;
   }
 
 //---------------------------------------------------------------------------------------
-
+// Removes the listener from its slot in the active list in constant time - the last
+// active listener moves into the vacated slot
 void SkookumScriptListenerManager::free_listener(USkookumScriptListener * listener_p)
   {
-  if (m_active_list.pop(*listener_p))
+  uint32_t slot_idx = listener_p->m_slot_idx;
+  if (slot_idx < m_active_list.get_length() && m_active_list[slot_idx] == listener_p)
     {
+    USkookumScriptListener * last_p = m_active_list.pop_last();
+    if (last_p != listener_p)
+      {
+      m_active_list[slot_idx] = last_p;
+      last_p->m_slot_idx = slot_idx;
+      }
+    listener_p->m_slot_idx = USkookumScriptListener::Slot_idx_none;
     listener_p->deinitialize();
     m_inactive_list.append(*listener_p);
     }
@@ -88,15 +99,167 @@ void SkookumScriptListenerManager::free_listener(USkookumScriptListener * listen
 
 //---------------------------------------------------------------------------------------
 
+SkookumScriptNativeListener * SkookumScriptListenerManager::alloc_native_listener(UObject * obj_p, SkInvokedCoroutine * coro_p, SkookumScriptNativeListener::tUnregisterCallback callback_p)
+  {
+  SkookumScriptNativeListener * listener_p = m_native_inactive_list.is_empty() ? new SkookumScriptNativeListener() : m_native_inactive_list.pop_last();
+  listener_p->initialize(obj_p, coro_p, callback_p);
+  listener_p->m_slot_idx = m_native_active_list.get_length();
+  m_native_active_list.append(*listener_p);
+  return listener_p;
+  }
+
+//---------------------------------------------------------------------------------------
+
+void SkookumScriptListenerManager::free_native_listener(SkookumScriptNativeListener * listener_p)
+  {
+  uint32_t slot_idx = listener_p->m_slot_idx;
+  if (slot_idx < m_native_active_list.get_length() && m_native_active_list[slot_idx] == listener_p)
+    {
+    deactivate_native_listener(listener_p);
+    m_native_inactive_list.append(*listener_p);
+    }
+  else
+    {
+    SK_ERRORX("SkookumScriptNativeListener not found in active list.");
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Hooks up a native listener to the dispatcher of the given delegate of obj_p, creating
+// and registering the dispatcher if there is none yet
+void SkookumScriptListenerManager::add_dispatched_listener(UObject * obj_p, FName delegate_name, SkookumScriptNativeListener * listener_p, USkookumScriptListener::tRegisterCallback register_f, USkookumScriptListener::tUnregisterCallback unregister_f)
+  {
+  SK_ASSERTX(!listener_p->m_dispatcher_p, "Native listener must not be dispatched to already.");
+
+  DispatchKey key(obj_p, delegate_name);
+  USkookumScriptListener ** dispatcher_pp = m_dispatchers.Find(key);
+  USkookumScriptListener * dispatcher_p = dispatcher_pp ? *dispatcher_pp : nullptr;
+
+  // A destroyed object may have left its dispatcher behind at the same address - that
+  // one is freed along with its last listener
+  if (dispatcher_p && dispatcher_p->m_obj_p.Get() != obj_p)
+    {
+    dispatcher_p = nullptr;
+    }
+
+  if (!dispatcher_p)
+    {
+    if (m_inactive_list.is_empty())
+      {
+      grow_inactive_list(m_pool_incr);
+      }
+    dispatcher_p = m_inactive_list.pop_last();
+    dispatcher_p->initialize_dispatcher(obj_p, delegate_name, unregister_f);
+    dispatcher_p->m_slot_idx = m_active_list.get_length();
+    m_active_list.append(*dispatcher_p);
+    m_dispatchers.Add(key, dispatcher_p);
+    (*register_f)(obj_p, dispatcher_p);
+    }
+
+  dispatcher_p->m_native_listeners.Add(listener_p);
+  listener_p->m_dispatcher_p = dispatcher_p;
+  }
+
+//---------------------------------------------------------------------------------------
+// Unhooks a native listener from its dispatcher and frees the dispatcher once it has no
+// listeners left
+void SkookumScriptListenerManager::remove_dispatched_listener(SkookumScriptNativeListener * listener_p)
+  {
+  USkookumScriptListener * dispatcher_p = listener_p->m_dispatcher_p;
+  listener_p->m_dispatcher_p = nullptr;
+
+  // Order of listeners does not matter
+  dispatcher_p->m_native_listeners.RemoveSingleSwap(listener_p, false);
+  if (dispatcher_p->m_native_listeners.Num() == 0)
+    {
+    DispatchKey key(dispatcher_p->m_dispatch_obj_p, dispatcher_p->m_dispatch_name);
+    USkookumScriptListener ** dispatcher_pp = m_dispatchers.Find(key);
+    if (dispatcher_pp && *dispatcher_pp == dispatcher_p)
+      {
+      m_dispatchers.Remove(key);
+      }
+    free_listener(dispatcher_p);
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Removes the native listener from its slot in the active list in constant time and
+// unbinds it from its delegate or dispatcher
+void SkookumScriptListenerManager::deactivate_native_listener(SkookumScriptNativeListener * listener_p)
+  {
+  uint32_t slot_idx = listener_p->m_slot_idx;
+  SkookumScriptNativeListener * last_p = m_native_active_list.pop_last();
+  if (last_p != listener_p)
+    {
+    m_native_active_list[slot_idx] = last_p;
+    last_p->m_slot_idx = slot_idx;
+    }
+  listener_p->m_slot_idx = SkookumScriptNativeListener::Slot_idx_none;
+
+  if (listener_p->m_dispatcher_p)
+    {
+    remove_dispatched_listener(listener_p);
+    }
+  listener_p->deinitialize();
+  }
+
+//---------------------------------------------------------------------------------------
+// Gives memory back after a spike of listeners or events - call regularly, e.g. once
+// per frame, with a small number of steps
+//
+// Returns: true if there is more to trim
+//
+// Params:
+//   max_steps: maximum number of free events to visit - also limits the number of idle
+//     listeners released since each of them is a whole UObject
+bool SkookumScriptListenerManager::trim(uint32_t max_steps)
+  {
+  // Rough cost of releasing a listener relative to visiting a free event
+  const uint32_t listener_step_cost = 64u;
+
+  m_event_pool.trim(max_steps);
+
+  for (uint32_t release_count = FMath::Max(max_steps / listener_step_cost, 1u);
+       release_count && m_inactive_list.get_length() > m_listener_keep_idle;
+       --release_count)
+    {
+    release_listener(m_inactive_list.pop_last());
+    }
+
+  // Native listeners are cheap to release
+  for (uint32_t release_count = max_steps;
+       release_count && m_native_inactive_list.get_length() > m_listener_keep_idle;
+       --release_count)
+    {
+    delete m_native_inactive_list.pop_last();
+    }
+
+  return m_event_pool.is_trimming()
+    || m_inactive_list.get_length() > m_listener_keep_idle
+    || m_native_inactive_list.get_length() > m_listener_keep_idle;
+  }
+
+//---------------------------------------------------------------------------------------
+
 void SkookumScriptListenerManager::grow_inactive_list(uint32_t pool_incr)
   {
   m_inactive_list.ensure_size(m_inactive_list.get_length() + pool_incr);
   for (uint32_t i = 0; i < pool_incr; ++i)
     {
     USkookumScriptListener * listener_p = NewObject<USkookumScriptListener>((UObject*)GetTransientPackage(), NAME_None);
-    listener_p->AddToRoot(); // Prevent listener object from ever getting garbage collected
+    listener_p->AddToRoot(); // Prevent listener object from getting garbage collected while pooled
     m_inactive_list.append(*listener_p);
     }
-  m_active_list.ensure_size(m_inactive_list.get_length());
+  m_active_list.ensure_size(m_active_list.get_length() + m_inactive_list.get_length());
   }
 
+//---------------------------------------------------------------------------------------
+
+void SkookumScriptListenerManager::release_listener(USkookumScriptListener * listener_p)
+  {
+  if (listener_p->IsValidLowLevel())
+    {
+    listener_p->RemoveFromRoot(); // Make listener object garbage collectable
+    listener_p->MarkPendingKill();
+    }
+  }
@@ -14,6 +14,7 @@
 //=======================================================================================
 
 #include "SkookumScriptListener.h"
+#include <AgogCore/AObjReusePoolTrimmable.hpp>
 #include <AgogCore/APArray.hpp>
 #include <SkookumScript/SkInstance.hpp>
 
@@ -26,34 +27,82 @@
 //=======================================================================================
 
 //---------------------------------------------------------------------------------------
-// Keep track of USkookumScriptListener instances
+// Keep track of USkookumScriptListener and SkookumScriptNativeListener instances
+//
+// Listeners are rooted UObjects that are reused rather than created for each coroutine.
+// Each active listener knows its slot in the active list so it can be freed in constant
+// time.  Native listeners are plain C++ objects reused the same way.  After a spike,
+// trim() lets go of idle listeners beyond the number to keep and gives unused event
+// memory back to the system.
+//
+// Native listeners of generated dynamic delegate events share one dispatcher listener
+// per object and delegate, looked up by m_dispatchers.
 class SkookumScriptListenerManager
   {
   public:
 
+    typedef AObjReusePoolTrimmable<SkookumScriptListenerBase::EventInfo> tEventPool;
+
     static SkookumScriptListenerManager *   get_singleton();
 
     // Methods
 
-    SkookumScriptListenerManager(uint32_t pool_init, uint32_t pool_incr);
+    SkookumScriptListenerManager(uint32_t listener_pool_init, uint32_t listener_pool_incr, uint32_t event_pool_init, uint32_t event_pool_incr);
     ~SkookumScriptListenerManager();
 
     USkookumScriptListener *                alloc_listener(UObject * obj_p, SkInvokedCoroutine * coro_p, USkookumScriptListener::tUnregisterCallback callback_p);
     void                                    free_listener(USkookumScriptListener * listener_p);
 
-    USkookumScriptListener::EventInfo *     alloc_event();
-    void                                    free_event(USkookumScriptListener::EventInfo * event_p, uint32_t num_arguments_to_free);
+    SkookumScriptNativeListener *           alloc_native_listener(UObject * obj_p, SkInvokedCoroutine * coro_p, SkookumScriptNativeListener::tUnregisterCallback callback_p);
+    void                                    free_native_listener(SkookumScriptNativeListener * listener_p);
+
+    void                                    add_dispatched_listener(UObject * obj_p, FName delegate_name, SkookumScriptNativeListener * listener_p, USkookumScriptListener::tRegisterCallback register_f, USkookumScriptListener::tUnregisterCallback unregister_f);
+
+    SkookumScriptListenerBase::EventInfo *     alloc_event();
+    void                                    free_event(SkookumScriptListenerBase::EventInfo * event_p, uint32_t num_arguments_to_free);
+
+    uint32_t                                get_listener_keep_idle() const                { return m_listener_keep_idle; }
+    void                                    set_listener_keep_idle(uint32_t keep_count)   { m_listener_keep_idle = keep_count; }
+    uint32_t                                get_active_count() const                      { return m_active_list.get_length(); }
+    uint32_t                                get_idle_count() const                        { return m_inactive_list.get_length(); }
+    uint32_t                                get_native_active_count() const               { return m_native_active_list.get_length(); }
+    uint32_t                                get_native_idle_count() const                 { return m_native_inactive_list.get_length(); }
+    const tEventPool &                      get_event_pool() const                        { return m_event_pool; }
+
+    bool                                    trim(uint32_t max_steps);
 
   protected:
 
     typedef APArray<USkookumScriptListener> tObjPool;
-    typedef AObjReusePool<USkookumScriptListener::EventInfo> tEventPool;
+    typedef APArray<SkookumScriptNativeListener> tNativePool;
+
+    // Identifies the dispatcher of a delegate of an object
+    struct DispatchKey
+      {
+      const UObject * m_obj_p;
+      FName           m_name;
+
+      DispatchKey(const UObject * obj_p, FName name) : m_obj_p(obj_p), m_name(name) {}
+      bool operator == (const DispatchKey & other) const { return m_obj_p == other.m_obj_p && m_name == other.m_name; }
+      friend uint32 GetTypeHash(const DispatchKey & key) { return HashCombine(PointerHash(key.m_obj_p), GetTypeHash(key.m_name)); }
+      };
+
+    typedef TMap<DispatchKey, USkookumScriptListener *> tDispatcherMap;
 
     void              grow_inactive_list(uint32_t pool_incr);
+    static void       release_listener(USkookumScriptListener * listener_p);
+    void              remove_dispatched_listener(SkookumScriptNativeListener * listener_p);
+    void              deactivate_native_listener(SkookumScriptNativeListener * listener_p);
 
     tObjPool          m_inactive_list;
     tObjPool          m_active_list;
     uint32_t          m_pool_incr;
+    uint32_t          m_listener_keep_idle; // Idle listeners trim() does not release
+
+    tNativePool       m_native_inactive_list;
+    tNativePool       m_native_active_list;
+
+    tDispatcherMap    m_dispatchers;
 
     tEventPool        m_event_pool;
 
@@ -65,14 +114,14 @@ class SkookumScriptListenerManager
 
 //---------------------------------------------------------------------------------------
 
-inline USkookumScriptListener::EventInfo * SkookumScriptListenerManager::alloc_event()
+inline SkookumScriptListenerBase::EventInfo * SkookumScriptListenerManager::alloc_event()
   {
   return m_event_pool.allocate();
   }
 
 //---------------------------------------------------------------------------------------
             
-inline void SkookumScriptListenerManager::free_event(USkookumScriptListener::EventInfo * event_p, uint32_t num_arguments_to_free)
+inline void SkookumScriptListenerManager::free_event(SkookumScriptListenerBase::EventInfo * event_p, uint32_t num_arguments_to_free)
   {
   for (uint32_t i = 0; i < num_arguments_to_free; ++i)
     {
@@ -13,6 +13,8 @@
 //=======================================================================================
 
 #include "SkookumScriptMindComponent.h"
+#include "Bindings/SkUERuntime.hpp"
+#include "Bindings/SkUEProfiler.hpp"
 #include <AgogCore/AString.hpp>
 #include <SkookumScript/SkBrain.hpp>
 #include <SkookumScript/SkClass.hpp>
@@ -70,7 +72,7 @@ void USkookumScriptMindComponent::delete_sk_instance()
   {
   SK_ASSERTX(m_mind_instance_p, "No Sk instance to delete!");
   m_mind_instance_p->clear_coroutines();
-  m_mind_instance_p->dereference();
+  SkUERuntime::get_singleton()->dereference_deferred(m_mind_instance_p);
   m_mind_instance_p = nullptr;
   }
 
@@ -94,6 +96,8 @@ void USkookumScriptMindComponent::InitializeComponent()
 
     create_sk_instance();
     m_mind_instance_p->get_class()->resolve_raw_data();
+
+    SKUE_PROFILE_SCOPE(m_mind_instance_p->get_class()->get_name(), ASymbolX_ctor);
     m_mind_instance_p->call_default_constructor();
     }
   }
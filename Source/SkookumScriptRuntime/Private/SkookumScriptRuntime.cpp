@@ -14,7 +14,11 @@
 #include "Bindings/SkUERuntime.hpp"
 #include "Bindings/SkUERemote.hpp"
 #include "Bindings/SkUEBlueprintInterface.hpp"
+#include "Bindings/SkUEProfiler.hpp"
+#include "Bindings/SkUEScheduler.hpp"
 #include "Bindings/SkUESymbol.hpp"
+#include "Bindings/SkUESlabAllocator.hpp"
+#include "Bindings/SkUETelemetry.hpp"
 #include "Bindings/SkUEUtils.hpp"
 
 #include "Runtime/Launch/Resources/Version.h"
@@ -26,7 +30,10 @@
 #include "SkookumScriptClassDataComponent.h"
 #include "SkookumScriptMindComponent.h"
 
+#include <AgogCore/ADeferRelease.hpp>
 #include <SkookumScript/SkSymbolDefs.hpp>
+#include <SkookumScript/SkDataInstance.hpp>
+#include <SkookumScript/SkInvokedCoroutine.hpp>
 
 #if defined(A_PLAT_PC)
 #define WIN32_LEAN_AND_MEAN
@@ -35,6 +42,10 @@
 
 // For profiling SkookumScript performance
 DECLARE_CYCLE_STAT(TEXT("SkookumScript Time"), STAT_SkookumScriptTime, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("SkookumScript Pool Trim"), STAT_SkookumScriptPoolTrim, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("SkookumScript Deferred Release"), STAT_SkookumScriptDeferredRelease, STATGROUP_Game);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("SkookumScript Release Queue"), STAT_SkookumScriptReleaseQueue, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SkookumScript Released Deferred"), STAT_SkookumScriptReleasedDeferred, STATGROUP_Game);
 
 //---------------------------------------------------------------------------------------
 // UE4 implementation of AAppInfoCore
@@ -45,6 +56,8 @@ class FAppInfo : public AAppInfoCore, public SkAppInfo
     FAppInfo();
     ~FAppInfo();
 
+    const SkUESlabAllocator &  get_allocator() const { return m_allocator; }
+
   protected:
 
     // AAppInfoCore implementation
@@ -63,6 +76,24 @@ class FAppInfo : public AAppInfoCore, public SkAppInfo
     virtual bool               use_builtin_actor() const override;
     virtual ASymbol            get_custom_actor_class_name() const override;
 
+  // Data Members
+
+    // Serves all AgogCore/SkookumScript memory requests
+    // As a member it outlives the AgogCore::initialize()/deinitialize() calls in ctor/dtor
+    SkUESlabAllocator          m_allocator;
+
+  };
+
+//---------------------------------------------------------------------------------------
+// Runs the SkookumScript update of a later phase of the world tick
+// - see SkUEScheduler::ePhase
+struct FSkookumScriptPhaseTickFunction : public FTickFunction
+  {
+  class FSkookumScriptRuntime * m_runtime_p;
+  SkUEScheduler::ePhase         m_phase;
+
+  virtual void    ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef & MyCompletionGraphEvent) override;
+  virtual FString DiagnosticMessage() override  { return TEXT("SkookumScript phase update"); }
   };
 
 //---------------------------------------------------------------------------------------
@@ -76,6 +107,8 @@ class FSkookumScriptRuntime : public ISkookumScriptRuntime
     FSkookumScriptRuntime();
     ~FSkookumScriptRuntime();
 
+    void          tick_phase(SkUEScheduler::ePhase phase);
+
   protected:
 
   // Methods
@@ -136,6 +169,10 @@ class FSkookumScriptRuntime : public ISkookumScriptRuntime
 
     void          tick_game(float deltaTime);
     void          tick_editor(float deltaTime);
+    void          register_phase_ticks(UWorld * world_p);
+    void          unregister_phase_ticks();
+    void          release_deferred();
+    void          trim_pools();
 
     #ifdef SKOOKUM_REMOTE_UNREAL
       void        tick_remote();
@@ -153,6 +190,11 @@ class FSkookumScriptRuntime : public ISkookumScriptRuntime
 
     mutable SkUERuntime     m_runtime;
 
+    SkUEScheduler           m_scheduler;
+
+    // Script updates in later phases of the world tick - indexed by phase - 1
+    FSkookumScriptPhaseTickFunction m_phase_ticks[SkUEScheduler::Phase__count - 1];
+
     #if WITH_EDITORONLY_DATA
       FSkookumScriptRuntimeGenerator  m_generator;
     #endif
@@ -162,6 +204,10 @@ class FSkookumScriptRuntime : public ISkookumScriptRuntime
       bool                  m_freshen_binaries_requested;
     #endif
 
+    #ifdef SKOOKUM_TELEMETRY_UNREAL
+      SkUETelemetry         m_telemetry;
+    #endif
+
     UWorld *                m_game_world_p;
     UWorld *                m_editor_world_p;
 
@@ -255,9 +301,11 @@ bool ASimpleErrorOutput::determine_choice(
   eAErrAction action     = AErrAction_ignore;
   bool        user_break = false;
 
+  // A lean dedicated server has no one to answer a modal dialog - it would just hang, so
+  // the error is only logged
   if (choice_p)
     {
-    #if defined(A_PLAT_PC)
+    #if defined(A_PLAT_PC) && !defined(SK_LEAN_SERVER)
 
       int result = ::MessageBoxA(
         NULL, desc, title_p, MB_ICONEXCLAMATION | MB_ABORTRETRYIGNORE | MB_DEFBUTTON1 | MB_SETFOREGROUND | MB_APPLMODAL);
@@ -307,12 +355,14 @@ FAppInfo::FAppInfo()
   AgogCore::initialize(this);
   SkookumScript::set_app_info(this);
   SkUESymbol::initialize();
+  SkUENameCache::initialize();
   }
 
 //---------------------------------------------------------------------------------------
 
 FAppInfo::~FAppInfo()
   {
+  SkUENameCache::deinitialize();
   SkUESymbol::deinitialize();
   SkookumScript::set_app_info(nullptr);
   AgogCore::deinitialize();
@@ -322,29 +372,29 @@ FAppInfo::~FAppInfo()
 
 void * FAppInfo::malloc(size_t size, const char * debug_name_p)
   {
-  return size ? FMemory::Malloc(size, 16) : nullptr; // $Revisit - MBreyer Make alignment controllable by caller
+  return size ? m_allocator.malloc(size) : nullptr; // $Revisit - MBreyer Make alignment controllable by caller
   }
 
 //---------------------------------------------------------------------------------------
 
 void FAppInfo::free(void * mem_p)
   {
-  if (mem_p) FMemory::Free(mem_p); // $Revisit - MBreyer Make alignment controllable by caller
+  if (mem_p) m_allocator.free(mem_p); // $Revisit - MBreyer Make alignment controllable by caller
   }
 
 //---------------------------------------------------------------------------------------
 
 uint32_t FAppInfo::request_byte_size(uint32_t size_requested)
   {
-  // Since we call the 16-byte aligned allocator
-  return a_align_up(size_requested, 16);
+  // Small requests are rounded up to their slab size class
+  return SkUESlabAllocator::request_byte_size(size_requested);
   }
 
 //---------------------------------------------------------------------------------------
 
 bool FAppInfo::is_using_fixed_size_pools()
   {
-  return false;
+  return true;
   }
 
 //---------------------------------------------------------------------------------------
@@ -411,6 +461,18 @@ ASymbol FAppInfo::get_custom_actor_class_name() const
   }
 
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// FSkookumScriptPhaseTickFunction
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+//---------------------------------------------------------------------------------------
+
+void FSkookumScriptPhaseTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef & MyCompletionGraphEvent)
+  {
+  m_runtime_p->tick_phase(m_phase);
+  }
+
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // FSkookumScriptRuntime
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -436,6 +498,26 @@ FSkookumScriptRuntime::FSkookumScriptRuntime()
   {
   //m_runtime.set_compiled_path("Scripts" SK_BITS_ID "\\");
 
+  static const ETickingGroup phase_tick_groups[SkUEScheduler::Phase__count - 1] =
+    {
+    TG_PrePhysics,     // SkUEScheduler::Phase_pre_physics
+    TG_PostPhysics,    // SkUEScheduler::Phase_post_physics
+    TG_PostUpdateWork, // SkUEScheduler::Phase_post_update_work
+    };
+
+  for (uint32 idx = 0u; idx < A_COUNT_OF(m_phase_ticks); ++idx)
+    {
+    FSkookumScriptPhaseTickFunction & tick_function = m_phase_ticks[idx];
+
+    tick_function.m_runtime_p                  = this;
+    tick_function.m_phase                      = SkUEScheduler::ePhase(idx + 1u);
+    tick_function.TickGroup                    = phase_tick_groups[idx];
+    tick_function.bCanEverTick                 = true;
+    tick_function.bStartWithTickEnabled        = true;
+    tick_function.bTickEvenWhenPaused          = false;
+    tick_function.bAllowTickOnDedicatedServer  = true;
+    }
+
   #if WITH_EDITORONLY_DATA 
     SkUEClassBindingHelper::set_runtime_generator(&m_generator);
   #endif
@@ -473,6 +555,10 @@ void FSkookumScriptRuntime::StartupModule()
 
   A_DPRINT("Starting up SkookumScript plug-in modules\n");
 
+  #ifdef SK_LEAN_SERVER
+    UE_LOG(LogSkookum, Display, TEXT("SkookumScript running as lean dedicated server - IDE connection, debug hooks, profiler, telemetry and error dialogs are compiled out."));
+  #endif
+
   // Note that FWorldDelegates::OnPostWorldCreation has world_p->WorldType set to None
   // Note that FWorldDelegates::OnPreWorldFinishDestroy has world_p->GetName() set to "None"
 
@@ -493,6 +579,14 @@ void FSkookumScriptRuntime::StartupModule()
       ensure_runtime_initialized();
       }
 
+  #ifdef SKOOKUM_TELEMETRY_UNREAL
+    m_telemetry.initialize();
+  #endif
+
+  #ifdef SKOOKUM_PROFILER_UNREAL
+    SkUEProfiler::initialize();
+  #endif
+
   //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
   // Send off connect request to IDE
   // Come back later to check on it
@@ -590,9 +684,17 @@ void FSkookumScriptRuntime::on_world_cleanup(UWorld * world_p, bool session_ende
     // Set world pointer to null if it was pointing to us
     if (m_game_world_p == world_p)
       {
+      unregister_phase_ticks();
       m_game_world_p->OnTickDispatch().Remove(m_game_tick_handle);
       m_game_world_p = nullptr;
       SkUEClassBindingHelper::set_world(nullptr);
+
+      // Let go of minds held back for a later phase of the world tick or tracked by the
+      // frame budget
+      m_scheduler.release_minds();
+
+      // Clean up instances still pending while the world they belong to is around
+      ADeferRelease::release_all();
       }
 
     // Restart SkookumScript if initialized
@@ -644,6 +746,14 @@ void FSkookumScriptRuntime::ShutdownModule()
   // So quick fix is to just not print during shutdown
   //A_DPRINT(A_SOURCE_STR " Shutting down SkookumScript plug-in modules\n");
 
+  #ifdef SKOOKUM_PROFILER_UNREAL
+    SkUEProfiler::deinitialize();
+  #endif
+
+  #ifdef SKOOKUM_TELEMETRY_UNREAL
+    m_telemetry.deinitialize();
+  #endif
+
   //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
   // Clean up SkookumScript
   m_runtime.shutdown();
@@ -818,14 +928,70 @@ void FSkookumScriptRuntime::tick_game(float deltaTime)
     tick_remote();
   #endif
 
+  // Registered here rather than on world init so the level is fully set up - ticks
+  // registered during the tick dispatch still run this frame
+  if (!m_phase_ticks[0].IsTickFunctionRegistered())
+    {
+    register_phase_ticks(m_game_world_p);
+    }
+
   // When paused, set deltaTime to 0.0
   #if WITH_EDITOR
     if (!m_game_world_p->IsPaused())
   #endif
       {
       SCOPE_CYCLE_COUNTER(STAT_SkookumScriptTime);
-      m_runtime.update(deltaTime);
+
+        {
+        SKUE_PROFILE_SCOPE(SkUEProfiler::get_symbol_skookum(), SkUEProfiler::get_symbol_update());
+        m_scheduler.update(deltaTime);
+        }
+
+      // Clean up instances let go of by actors and components that went away
+      release_deferred();
       }
+
+  trim_pools();
+
+  #ifdef SKOOKUM_TELEMETRY_UNREAL
+    m_telemetry.update(m_app_info.get_allocator());
+  #endif
+  }
+
+//---------------------------------------------------------------------------------------
+// Update the SkookumScript minds assigned to a later phase of the world tick
+//
+// #Params:
+//   phase: phase of the world tick that is running
+void FSkookumScriptRuntime::tick_phase(SkUEScheduler::ePhase phase)
+  {
+  SCOPE_CYCLE_COUNTER(STAT_SkookumScriptTime);
+  SKUE_PROFILE_SCOPE(SkUEProfiler::get_symbol_skookum(), SkUEProfiler::get_symbol_update());
+
+  m_scheduler.update_phase(phase);
+  }
+
+//---------------------------------------------------------------------------------------
+// Registers the tick functions of the later phases with the persistent level of a world
+void FSkookumScriptRuntime::register_phase_ticks(UWorld * world_p)
+  {
+  for (FSkookumScriptPhaseTickFunction & tick_function : m_phase_ticks)
+    {
+    tick_function.RegisterTickFunction(world_p->PersistentLevel);
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Unregisters the tick functions of the later phases
+void FSkookumScriptRuntime::unregister_phase_ticks()
+  {
+  for (FSkookumScriptPhaseTickFunction & tick_function : m_phase_ticks)
+    {
+    if (tick_function.IsTickFunctionRegistered())
+      {
+      tick_function.UnRegisterTickFunction();
+      }
+    }
   }
 
 //---------------------------------------------------------------------------------------
@@ -843,6 +1009,51 @@ void FSkookumScriptRuntime::tick_editor(float deltaTime)
   #endif
   }
 
+//---------------------------------------------------------------------------------------
+// Cleans up instances queued by SkUERuntime::dereference_deferred() for a small fixed
+// amount of time per frame
+void FSkookumScriptRuntime::release_deferred()
+  {
+  // Time allowed per frame and objects released between time checks
+  const double   budget_secs = 0.0005;
+  const uint32_t step_count  = 16u;
+
+  SCOPE_CYCLE_COUNTER(STAT_SkookumScriptDeferredRelease);
+
+  uint32_t released_count = 0u;
+  if (ADeferRelease::get_length())
+    {
+    double end_time = FPlatformTime::Seconds() + budget_secs;
+    do 
+      {
+      released_count += ADeferRelease::release(step_count);
+      } while (ADeferRelease::get_length() && FPlatformTime::Seconds() < end_time);
+    }
+
+  SET_DWORD_STAT(STAT_SkookumScriptReleaseQueue, ADeferRelease::get_length());
+  SET_DWORD_STAT(STAT_SkookumScriptReleasedDeferred, released_count);
+  }
+
+//---------------------------------------------------------------------------------------
+// Gives memory of the listener and event pools back to the system after a usage spike.
+// Only spends a small fixed amount of time per frame so it never causes a hitch.
+// Notes:      The SkInstance, SkInvokedExpression etc. pools are owned by the precompiled
+//             SkookumScript library which allocates from them with its own inlined copy
+//             of AObjReusePool - they can not be trimmed from here.
+void FSkookumScriptRuntime::trim_pools()
+  {
+  // Time allowed per frame and free objects visited between time checks
+  const double   budget_secs = 0.0001;
+  const uint32_t step_count  = 256u;
+
+  SCOPE_CYCLE_COUNTER(STAT_SkookumScriptPoolTrim);
+
+  double end_time = FPlatformTime::Seconds() + budget_secs;
+  while (m_runtime.get_listener_manager()->trim(step_count) && FPlatformTime::Seconds() < end_time)
+    {
+    }
+  }
+
 #ifdef SKOOKUM_REMOTE_UNREAL
 
 //---------------------------------------------------------------------------------------
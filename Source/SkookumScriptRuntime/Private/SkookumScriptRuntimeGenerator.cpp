@@ -19,6 +19,7 @@
 
 FSkookumScriptRuntimeGenerator::FSkookumScriptRuntimeGenerator(ISkookumScriptRuntimeInterface * runtime_interface_p)
   : m_runtime_interface_p(runtime_interface_p)
+  , m_overlay_index_valid(false)
   {
   // Clear contents of scripts folder for a fresh start
   // Won't work here if project has several maps using different blueprints
@@ -184,6 +185,7 @@ UBlueprint * FSkookumScriptRuntimeGenerator::load_blueprint_asset(const FString
       if (package_path_begin_pos >= 0)
         {
         IFileManager::Get().DeleteDirectory(*full_class_path, false, true);
+        m_overlay_index_valid = false;
         }
       return nullptr;
       }
@@ -242,6 +244,7 @@ UBlueprint * FSkookumScriptRuntimeGenerator::load_blueprint_asset(const FString
             {
             // User requested deletion, so nuke it
             IFileManager::Get().DeleteDirectory(*full_class_path, false, true);
+            m_overlay_index_valid = false;
             *sk_class_deleted_p = true;
             m_runtime_interface_p->on_class_scripts_changed_by_generator(class_name, ISkookumScriptRuntimeInterface::ChangeType_deleted);
             }
@@ -339,15 +342,10 @@ void FSkookumScriptRuntimeGenerator::generate_class_script_files(UClass * ue_cla
     // Make sure there is no other folder with the same name around
     if (check_if_reparented)
       {
+      // Find any folder named either class_name or parent_name.class_name
+      ensure_overlay_index();
       TArray<FString> found_folders;
-      // 1) Try to find any folder with the exact class_name
-      IFileManager::Get().FindFilesRecursive(found_folders, *m_overlay_path, *class_name, false, true);
-      if (found_folders.Num() == 0)
-        {
-        // 2) Try to find any folder with the pattern parent_name.class_name
-        FString pattern = TEXT("*.") + class_name;
-        IFileManager::Get().FindFilesRecursive(found_folders, *m_overlay_path, *pattern, false, true);
-        }
+      m_overlay_index.MultiFind(class_name, found_folders);
       // Found anything?
       for (FString & folder_path : found_folders)
         {
@@ -356,6 +354,8 @@ void FSkookumScriptRuntimeGenerator::generate_class_script_files(UClass * ue_cla
           {
           // No, delete
           IFileManager::Get().DeleteDirectory(*folder_path, false, true);
+          m_overlay_index.RemoveSingle(class_name, folder_path);
+          remove_file_manifest_entries(folder_path);
           }
         }
       }
@@ -377,6 +377,12 @@ void FSkookumScriptRuntimeGenerator::generate_class_script_files(UClass * ue_cla
         }
       }
 
+    // Keep the index up to date with the folder we just populated
+    if (m_overlay_index_valid)
+      {
+      m_overlay_index.AddUnique(class_name, class_path);
+      }
+
     if (anything_changed)
       {
       //tSourceControlCheckoutFunc checkout_f = ISourceControlModule::Get().IsEnabled() ? &SourceControlHelpers::CheckOutFile : nullptr;
@@ -408,6 +414,9 @@ void FSkookumScriptRuntimeGenerator::generate_used_class_script_files()
     }
 
   m_used_classes.Empty();
+
+  // Remember which files we verified to be up to date
+  save_file_manifest();
   }
 
 //---------------------------------------------------------------------------------------
@@ -465,6 +474,9 @@ void FSkookumScriptRuntimeGenerator::rename_class_script_files(UClass * ue_class
           {
           report_error(FString::Printf(TEXT("Couldn't rename class from '%s' to '%s'"), *old_class_path, *this_class_path));
           }
+        m_overlay_index_valid = false;
+        remove_file_manifest_entries(old_class_path);
+        remove_file_manifest_entries(this_class_path);
         // Regenerate the meta file to correctly reflect the Blueprint it originated from
         generate_class_script_files(ue_class_p, false, false, false);
         // Inform the runtime module of the change
@@ -495,6 +507,9 @@ void FSkookumScriptRuntimeGenerator::delete_class_script_files(UClass * ue_class
   if (FPaths::DirectoryExists(directory_to_delete))
     {
     IFileManager::Get().DeleteDirectory(*directory_to_delete, false, true);
+    m_overlay_index.RemoveSingle(class_name, directory_to_delete);
+    remove_file_manifest_entries(directory_to_delete);
+    save_file_manifest();
     m_runtime_interface_p->on_class_scripts_changed_by_generator(class_name, ISkookumScriptRuntimeInterface::ChangeType_deleted);
     }
   }
@@ -544,6 +559,44 @@ void FSkookumScriptRuntimeGenerator::set_overlay_path()
     m_overlay_path = FPaths::ConvertRelativePathToFull(scripts_path / overlay_name_bp_p);
     }
   compute_scripts_path_depth(m_project_file_path, overlay_name_bp_p);
+
+  // Overlay changed so rescan it when needed
+  m_overlay_index_valid = false;
+
+  // Keep track of what we generated across sessions
+  set_file_manifest_path(FPaths::GameIntermediateDir() / TEXT("SkookumScript") / FString(overlay_name_bp_p) + TEXT(".manifest"));
+  }
+
+//---------------------------------------------------------------------------------------
+// Scan the overlay once for class folders so reparenting can be detected by lookup
+void FSkookumScriptRuntimeGenerator::ensure_overlay_index()
+  {
+  if (!m_overlay_index_valid)
+    {
+    m_overlay_index.Reset();
+
+    TArray<FString> found_folders;
+    IFileManager::Get().FindFilesRecursive(found_folders, *m_overlay_path, TEXT("*"), false, true);
+    for (FString & folder_path : found_folders)
+      {
+      m_overlay_index.Add(get_overlay_index_key(folder_path), folder_path);
+      }
+
+    m_overlay_index_valid = true;
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Class folders are either named class_name or parent_name.class_name
+FString FSkookumScriptRuntimeGenerator::get_overlay_index_key(const FString & folder_path)
+  {
+  FString folder_name = FPaths::GetCleanFilename(folder_path);
+  int32 dot_pos = INDEX_NONE;
+  if (folder_name.FindLastChar(TCHAR('.'), dot_pos))
+    {
+    folder_name = folder_name.Mid(dot_pos + 1);
+    }
+  return folder_name;
   }
 
 #endif // WITH_EDITORONLY_DATA
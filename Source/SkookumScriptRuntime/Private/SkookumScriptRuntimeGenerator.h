@@ -72,9 +72,13 @@ class FSkookumScriptRuntimeGenerator : public FSkookumScriptGeneratorBase
     void          initialize_paths();
     void          set_overlay_path();
 
+    void          ensure_overlay_index();
+    static FString get_overlay_index_key(const FString & folder_path);
+
     // Types
 
     typedef TSet<UStruct *> tUsedClasses;
+    typedef TMultiMap<FString, FString> tOverlayIndex;
 
     // Data members
 
@@ -88,6 +92,9 @@ class FSkookumScriptRuntimeGenerator : public FSkookumScriptGeneratorBase
 
     tUsedClasses  m_used_classes;       // All classes used as types (by parameters, properties etc.)
 
+    tOverlayIndex m_overlay_index;      // All class folders in the overlay, keyed by class name - so we don't have to scan the overlay to detect reparenting
+    bool          m_overlay_index_valid; // If m_overlay_index reflects what's on disk
+
   };
 
 #endif // WITH_EDITORONLY_DATA
\ No newline at end of file
@@ -0,0 +1,26 @@
+//=======================================================================================
+// SkookumScript Plugin for Unreal Engine 4
+// Copyright (c) 2015 Agog Labs Inc. All rights reserved.
+//
+// SkookumScript EventFilter (= FSkookumScriptEventFilter) class
+//=======================================================================================
+
+#pragma once
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include <SkookumScript/SkClassBinding.hpp>
+#include "SkookumScriptListener.h"
+
+//---------------------------------------------------------------------------------------
+// SkookumScript EventFilter (= FSkookumScriptEventFilter) class
+class SKOOKUMSCRIPTRUNTIME_API SkUEEventFilter : public SkClassBindingSimple<SkUEEventFilter, FSkookumScriptEventFilter>
+  {
+  public:
+
+    static void       register_bindings();
+    static SkClass *  get_class();
+
+  };
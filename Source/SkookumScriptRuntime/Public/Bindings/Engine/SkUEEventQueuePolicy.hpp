@@ -0,0 +1,26 @@
+//=======================================================================================
+// SkookumScript Plugin for Unreal Engine 4
+// Copyright (c) 2015 Agog Labs Inc. All rights reserved.
+//
+// SkookumScript EventQueuePolicy (= FSkookumScriptEventQueuePolicy) class
+//=======================================================================================
+
+#pragma once
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include <SkookumScript/SkClassBinding.hpp>
+#include "SkookumScriptListener.h"
+
+//---------------------------------------------------------------------------------------
+// SkookumScript EventQueuePolicy (= FSkookumScriptEventQueuePolicy) class
+class SKOOKUMSCRIPTRUNTIME_API SkUEEventQueuePolicy : public SkClassBindingSimple<SkUEEventQueuePolicy, FSkookumScriptEventQueuePolicy>
+  {
+  public:
+
+    static void       register_bindings();
+    static SkClass *  get_class();
+
+  };
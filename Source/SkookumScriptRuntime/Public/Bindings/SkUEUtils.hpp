@@ -16,6 +16,45 @@
 #include <AgogCore/AString.hpp>
 #include <AgogCore/ASymbol.hpp>
 
+//=======================================================================================
+// Global Structures
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+// Cache of `ASymbol` <-> `FName` conversions.
+// 
+// Converting between the two otherwise goes through a string in both directions - hashing
+// it and locking the global name table or the symbol table each time. This cache
+// remembers each conversion the first time it is made so that subsequent ones are a
+// single table lookup keyed by the symbol id or by the name index - without any string
+// work.
+// 
+// Each direction is stored in a fixed size open addressing table that is filled lazily and
+// never shrinks, so lookups are lock-free. If a table is full or too crowded around a
+// given key, the conversion is simply performed uncached.
+class SKOOKUMSCRIPTRUNTIME_API SkUENameCache
+  {
+  public:
+
+  // Constants
+
+    enum
+      {
+      Capacity  = 8192, // Number of slots per table - must be a power of 2
+      Probe_max = 16    // Maximum number of slots inspected per lookup before giving up
+      };
+
+  // Class Methods
+
+    static void    initialize();
+    static void    deinitialize();
+
+    static FName   get_fname(const ASymbol & sym, bool add_if_missing = true);
+    static ASymbol get_symbol(const FName & name);
+
+  };  // SkUENameCache
+
+
 //=======================================================================================
 // Global Functions
 //=======================================================================================
@@ -30,8 +69,9 @@ inline AString FStringToAString(const FString & str)
 //---------------------------------------------------------------------------------------
 inline ASymbol FStringToASymbol(const FString & str)
   {
-  // $Revisit - CReis Look into StringCast<>
-  return ASymbol::create(AString(*str, str.Len()));
+  // Narrow on the stack rather than going through a temporary AString
+  auto ansi_str = StringCast<ANSICHAR>(*str, str.Len());
+  return ASymbol::create(ansi_str.Get(), uint32_t(ansi_str.Length()), ATerm_short);
   }
 
 //---------------------------------------------------------------------------------------
@@ -69,3 +109,20 @@ inline FName AStringToExistingFName(const AString & str)
   // $Revisit - CReis Look into StringCast<>
   return FName(str.as_cstr(), FNAME_Find);
   }
+
+//---------------------------------------------------------------------------------------
+// Converts `ASymbol` to `FName` - repeated conversions of the same symbol are served by
+// `SkUENameCache`. May be called from any thread.
+inline FName ASymbolToFName(const ASymbol & sym)
+  {
+  return SkUENameCache::get_fname(sym);
+  }
+
+//---------------------------------------------------------------------------------------
+// Converts `FName` (including any number suffix) to `ASymbol` - repeated conversions of
+// the same name are served by `SkUENameCache`. Game thread only since new names create
+// symbols.
+inline ASymbol FNameToASymbol(const FName & name)
+  {
+  return SkUENameCache::get_symbol(name);
+  }
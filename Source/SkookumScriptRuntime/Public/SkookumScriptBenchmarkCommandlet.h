@@ -0,0 +1,112 @@
+//=======================================================================================
+// SkookumScript Plugin for Unreal Engine 4
+// Copyright (c) 2016 Agog Labs Inc. All rights reserved.
+//
+// Commandlet running a standard set of scripting benchmarks
+//=======================================================================================
+
+#pragma once
+
+//=======================================================================================
+// Includes
+//=======================================================================================
+
+#include "Commandlets/Commandlet.h"
+#include "SkookumScriptBenchmarkCommandlet.generated.h"
+
+//=======================================================================================
+// Global Defines / Macros
+//=======================================================================================
+
+class AActor;
+class SkClass;
+class UWorld;
+
+//=======================================================================================
+// Global Structures
+//=======================================================================================
+
+//---------------------------------------------------------------------------------------
+// Runs the scripting benchmarks and writes their timings as JSON - e.g.:
+//
+//   UE4Editor-Cmd.exe MyGame -run=SkookumScriptBenchmark -nullrhi
+//
+// The script workloads are class methods of `SkookumBenchmark` in the Benchmark overlay
+// (Scripts/Benchmark in the plugin folder) which must be enabled in the project's
+// Skookum-project.ini and compiled into the binaries.  Everything runs in a temporary
+// game world without connecting to the SkookumIDE.
+//
+// Switches:
+//   -Output=<file>     JSON file to write (default Saved/Profiling/SkookumScript/Benchmark.json)
+//   -Baseline=<file>   JSON file to compare with - must exist (default Scripts/Benchmark/Baseline.json)
+//   -Gated             Fail if the default baseline does not exist
+//   -Tolerance=<x>     Fraction a workload may be slower than the baseline (default 0.1)
+//   -UpdateBaseline    Write the results to the baseline file instead of comparing
+//   -Ungated           Only write the results without comparing them with a baseline
+//   -Scale=<x>         Multiplier for the iterations of every workload (default 1.0)
+//   -Repeat=<n>        Runs of each workload - the fastest one counts (default 3)
+//   -Threads=<n>       Threads of the concurrent pool workload (default 4)
+//
+// Returns 1 if a workload was slower than the baseline allows or could not run, or if
+// the baseline is not of the current workloads.  Until a baseline is recorded with
+// -UpdateBaseline the default run only writes the results - -Gated or -Baseline=<file>
+// make a missing baseline fail too.
+UCLASS()
+class USkookumScriptBenchmarkCommandlet : public UCommandlet
+  {
+
+    GENERATED_UCLASS_BODY()
+
+  public:
+
+  // Methods
+
+    // UCommandlet interface
+    virtual int32 Main(const FString & params) override;
+
+  protected:
+
+  // Types
+
+    typedef TFunction<void(uint32 iterations)> tWorkloadFunc;
+
+    // Timing of a single workload
+    struct Result
+      {
+      FString m_name;
+      uint32  m_iterations;
+      double  m_msecs;        // Fastest run
+
+      double get_nsecs_per_iteration() const { return m_iterations ? m_msecs * 1000000.0 / m_iterations : 0.0; }
+      };
+
+  // Internal Methods
+
+    void  run_workload(const FString & name, uint32 iterations, const tWorkloadFunc & workload_f, const tWorkloadFunc & setup_f = nullptr);
+    void  run_script_workload(const FString & name, uint32 iterations, bool pass_actor_b = false);
+    void  run_script_workloads();
+    void  run_native_workloads();
+    void  run_lookup_workloads(uint32 table_length);
+    void  run_load_workloads(uint32 load_length);
+
+    bool  setup_world();
+    void  teardown_world();
+    void  tick_world();
+
+    bool  write_results(const FString & file_path) const;
+    bool  compare_to_baseline(const FString & file_path, float tolerance) const;
+
+  // Internal Data Members
+
+    UWorld *          m_world_p;
+    TArray<AActor *>  m_actors;
+    SkClass *         m_benchmark_class_p;
+
+    float             m_scale;
+    int32             m_repeat;
+    int32             m_thread_count;
+
+    TArray<Result>    m_results;
+    bool              m_failed_b;
+
+  };  // USkookumScriptBenchmarkCommandlet
@@ -2,7 +2,7 @@
 // SkookumScript Plugin for Unreal Engine 4
 // Copyright (c) 2015 Agog Labs Inc. All rights reserved.
 //
-// UObject that listens to dynamic multicast delegate events
+// Listeners to dynamic and native multicast delegate events
 // 
 // Author(s): Markus Breyer
 //=======================================================================================
@@ -31,19 +31,84 @@
 class SkInstance;
 class SkInvokedCoroutine;
 class USkookumScriptListener;
+class SkookumScriptNativeListener;
 
 //=======================================================================================
 // Global Structures
 //=======================================================================================
 
 //---------------------------------------------------------------------------------------
-// UObject-derived proxy class allowing callbacks from dynamic delegates
-UCLASS()
-class SKOOKUMSCRIPTRUNTIME_API USkookumScriptListener : public UObject
+// Declarative test of a single event argument evaluated natively before an event is
+// queued - events that fail it neither resume the coroutine nor run its closure.
+// Created in script with the `EventFilter` constructors and passed to `_on_x_do()` or
+// `_on_x_do_until()`.
+struct SKOOKUMSCRIPTRUNTIME_API FSkookumScriptEventFilter
   {
+  enum eKind
+    {
+    Kind_none,      // Every event passes
+    Kind_class,     // Object argument must be of m_class_p
+    Kind_object,    // Object argument must be m_object_p
+    Kind_at_least   // Number argument or length of vector argument must be >= m_min_value
+    };
+
+  eKind                   m_kind;
+  uint32_t                m_arg_idx;    // Index of the event argument tested
+  UClass *                m_class_p;
+  TWeakObjectPtr<UObject> m_object_p;
+  float                   m_min_value;
+
+  FSkookumScriptEventFilter() : m_kind(Kind_none), m_arg_idx(0u), m_class_p(nullptr), m_min_value(0.0f) {}
+
+  bool is_active() const        { return m_kind != Kind_none; }
+  uint32_t get_arg_idx() const  { return m_arg_idx; }
+
+  bool test_object(const UObject * obj_p);
+  bool test_scalar(float value);
+  bool test_vector(const FVector & vector)  { return test_scalar(vector.Size()); }
+  bool test_hit(const FHitResult & hit);
+  bool test_instance(SkInstance * arg_p);
+  bool test_unsupported();
+  };
 
-    GENERATED_UCLASS_BODY()
+//---------------------------------------------------------------------------------------
+// How events are coalesced while they wait for the coroutine to consume them - keeps the
+// queue and the closure loop of `_on_x_do()` bounded during event storms.  Created in
+// script with the `EventQueuePolicy` constructors and passed to `_on_x_do()` or
+// `_on_x_do_until()`.
+struct SKOOKUMSCRIPTRUNTIME_API FSkookumScriptEventQueuePolicy
+  {
+  enum eKind
+    {
+    Kind_keep_all,      // Queue every event - default
+    Kind_keep_first,    // Drop events while one is queued
+    Kind_keep_latest,   // Drop queued events when a new one arrives
+    Kind_dedupe,        // New event replaces a queued one with the same key argument
+    Kind_wait_first     // Like Kind_keep_first but set by wait coroutines that only return the first event - not counted as dropped
+    };
+
+  eKind     m_kind;
+  uint32_t  m_key_arg_idx;  // Index of the key argument of Kind_dedupe
+  uint32_t  m_max_count;    // Oldest events are dropped beyond this many - 0 = unbounded
+
+  FSkookumScriptEventQueuePolicy(eKind kind = Kind_keep_all, uint32_t key_arg_idx = 0u, uint32_t max_count = 0u) : m_kind(kind), m_key_arg_idx(key_arg_idx), m_max_count(max_count) {}
+  };
 
+//---------------------------------------------------------------------------------------
+// Event queue shared by all listeners - holds the events a delegate callback passes on
+// until the coroutine waiting for them consumes them.
+//
+// Generated event callbacks copy the raw delegate parameters into a payload ring buffer
+// (alloc_payload() + push_payload_and_resume()) and they are only boxed into SkInstances
+// by pop_event() when a coroutine actually consumes the event - events discarded by
+// `_wait_x` never get boxed at all.  Callbacks may also box right away and queue an
+// EventInfo (alloc_event() + push_event_and_resume()) - a listener uses one or the other.
+//
+// An optional event filter (m_filter) is tested first - by push_event_and_resume() on
+// the boxed arguments and by callbacks on the raw parameters.  The queue policy
+// (m_queue_policy) is then applied when the event is queued.
+class SKOOKUMSCRIPTRUNTIME_API SkookumScriptListenerBase
+  {
   public:
 
   // Types
@@ -55,6 +120,113 @@ class SKOOKUMSCRIPTRUNTIME_API USkookumScriptListener : public UObject
       EventInfo **  get_pool_unused_next() { return (EventInfo **)&m_argument_p[0]; } // Area in this class where to store the pointer to the next unused object when not in use
       };
 
+    // Boxes a raw event payload into arguments (unless args_pp is null) and destructs it
+    typedef void (*tUnpackPayload)(void * payload_p, SkInstance ** args_pp);
+
+    // Gets an event payload argument as key for FSkookumScriptEventQueuePolicy::Kind_dedupe
+    // - Key_unsupported if the argument cannot be used as key
+    typedef uint64 (*tPayloadKey)(const void * payload_p, uint32_t arg_idx);
+
+  // Constants
+
+    enum
+      {
+      Payload_alignment       = 16,   // Max alignment of event payload types
+      Payload_init_capacity   = 4,    // Payloads the ring buffer holds at first
+      Payload_keep_bytes      = 1024  // Ring buffer larger than this is freed when listener goes idle
+      };
+
+    static const uint64 Key_unsupported = ~uint64(0);
+
+  // Common Methods
+
+    SkookumScriptListenerBase();
+
+  // Methods
+
+    uint32_t                    get_num_arguments() const { return m_num_arguments; }
+    FSkookumScriptEventFilter & get_filter()              { return m_filter; }
+    void                        set_filter(const FSkookumScriptEventFilter & filter) { m_filter = filter; }
+    void                        set_queue_policy(const FSkookumScriptEventQueuePolicy & policy) { m_queue_policy = policy; }
+    uint32_t                    get_dropped_count() const { return m_dropped_count; }
+
+    bool                has_event() const;
+    EventInfo *         pop_event();
+    void                free_event(EventInfo * event_p, bool free_arguments);
+    void                discard_events();
+
+    // Called by delegate callbacks
+
+    static EventInfo *  alloc_event();
+    void                push_event_and_resume(EventInfo * event_p, uint32_t num_arguments);
+    void *              alloc_payload(uint32_t payload_size, uint32_t num_arguments, tUnpackPayload unpack_f, tPayloadKey key_f = nullptr);
+    void                push_payload_and_resume();
+
+  protected:
+
+    friend class AObjReusePool<EventInfo>;
+
+  // Internal Methods
+
+    void                initialize_events(SkInvokedCoroutine * coro_p);
+    void                deinitialize_events();
+    void                grow_payload_buffer();
+    void *              get_payload(uint32_t payload_idx) { return m_payload_buffer.GetData() + payload_idx * m_payload_size; }
+
+    void                drop_oldest_event();
+    bool                dedupe_event(SkInstance ** args_pp);
+    bool                dedupe_payload();
+    void                report_unsupported_key();
+    static uint64       get_instance_key(SkInstance * arg_p);
+
+    static void         set_event_args(SkInvokedCoroutine * scope_p, SkookumScriptListenerBase * listener_p);
+    static bool         run_event_closure(SkInvokedCoroutine * scope_p, SkookumScriptListenerBase * listener_p, bool do_until);
+    static bool         return_first_event(SkInvokedCoroutine * scope_p, SkookumScriptListenerBase * listener_p);
+
+  // Internal Data Members
+
+    AIdPtr<SkInvokedCoroutine>  m_coro_p;                // The coroutine that is suspended waiting for events from this object
+    AList<EventInfo>            m_event_queue;           // Queued up events waiting to be processed
+    uint32_t                    m_event_count;           // Number of events in m_event_queue
+    uint32_t                    m_num_arguments;         // How many arguments the event has
+
+    // Raw event payloads waiting to be boxed - ring buffer of m_payload_size byte slots
+    TArray<uint8, TAlignedHeapAllocator<Payload_alignment>> m_payload_buffer;
+    uint32_t                    m_payload_size;          // Bytes per payload
+    uint32_t                    m_payload_first;         // Slot of oldest payload
+    uint32_t                    m_payload_count;         // Number of payloads queued up
+    tUnpackPayload              m_unpack_payload_f;      // How to box and destruct a payload
+    tPayloadKey                 m_payload_key_f;         // How to get a key argument of a payload
+
+    FSkookumScriptEventFilter   m_filter;                // Events not passing it are dropped
+    FSkookumScriptEventQueuePolicy m_queue_policy;       // How events are coalesced
+    uint32_t                    m_dropped_count;         // Events dropped by a queue policy set from script since initialize
+
+  };  // SkookumScriptListenerBase
+
+//---------------------------------------------------------------------------------------
+// UObject-derived proxy class allowing callbacks from dynamic delegates
+//
+// Dynamic delegates can only call UFunctions on UObjects, so each listener is a rooted
+// UObject and each broadcast goes through ProcessEvent().  Native delegates are better
+// served by SkookumScriptNativeListener.
+//
+// A listener can also act as dispatcher shared by all coroutines waiting on the same
+// delegate of the same object - see add_dispatched_listener().  Its callback then hands
+// the parameters to the static trampoline of each of its native listeners, so there is
+// one UObject and one ProcessEvent() per object and delegate rather than per coroutine.
+UCLASS()
+class SKOOKUMSCRIPTRUNTIME_API USkookumScriptListener : public UObject, public SkookumScriptListenerBase
+  {
+
+    GENERATED_UCLASS_BODY()
+
+  public:
+
+  // Types
+
+    static const uint32_t Slot_idx_none = 0xffffffffu; // m_slot_idx when not in use
+
     typedef void (*tRegisterCallback)(UObject *, USkookumScriptListener *);
     typedef void (*tUnregisterCallback)(UObject *, USkookumScriptListener *);
 
@@ -65,36 +237,87 @@ class SKOOKUMSCRIPTRUNTIME_API USkookumScriptListener : public UObject
     void                initialize(UObject * obj_p, SkInvokedCoroutine * coro_p, tUnregisterCallback callback_p);
     void                deinitialize();
 
-    uint32_t            get_num_arguments() const { return m_num_arguments; }
-
-    bool                has_event() const;
-    EventInfo *         pop_event();
-    void                free_event(EventInfo * event_p, bool free_arguments);
-
     static bool         coro_on_event_do(SkInvokedCoroutine * scope_p, tUnregisterCallback register_f, tUnregisterCallback unregister_f, bool do_until);
     static bool         coro_wait_event(SkInvokedCoroutine * scope_p, tUnregisterCallback register_f, tUnregisterCallback unregister_f);
 
   protected:
 
-    friend class AObjReusePool<EventInfo>;
+    friend class SkookumScriptListenerManager;
 
   // Internal Methods
 
-    static EventInfo *  alloc_event();
-    void                push_event_and_resume(EventInfo * event_p, uint32_t num_arguments);
     static void         add_dynamic_function(FName callback_name, UClass * callback_owner_class_p, Native exec_p);
     static void         remove_dynamic_function(FName callback_name);
+    static void         add_dispatched_listener(UObject * obj_p, FName delegate_name, SkookumScriptNativeListener * listener_p, tRegisterCallback register_f, tUnregisterCallback unregister_f);
+
+    void                initialize_dispatcher(UObject * obj_p, FName delegate_name, tUnregisterCallback callback_p);
+
+    const TArray<SkookumScriptNativeListener *> & get_native_listeners() const { return m_native_listeners; }
 
   // Internal Data Members
 
     FWeakObjectPtr              m_obj_p;                 // UObject we belong to
-    AIdPtr<SkInvokedCoroutine>  m_coro_p;                // The coroutine that is suspended waiting for events from this object
-    AList<EventInfo>            m_event_queue;           // Queued up events waiting to be processed
-    uint32_t                    m_num_arguments;         // How many arguments the event has
     tUnregisterCallback         m_unregister_callback_p; // How to unregister myself from the delegate list I am hooked up to
+    uint32_t                    m_slot_idx;              // Index in active list of SkookumScriptListenerManager while in use
+
+    // Set while dispatching to native listeners
+    const UObject *             m_dispatch_obj_p;        // m_obj_p as dispatcher key - stays put when the object goes away
+    FName                       m_dispatch_name;         // Name of the delegate dispatched
+    TArray<SkookumScriptNativeListener *> m_native_listeners; // Listeners fed by this dispatcher
 
   };  // USkookumScriptListener
 
+//---------------------------------------------------------------------------------------
+// Plain C++ listener for native multicast delegates (DECLARE_MULTICAST_DELEGATE etc.)
+//
+// The register callback binds a C++ trampoline with the listener as payload - e.g. with
+// AddStatic() or AddRaw() - and hands the delegate handle to set_delegate_handle() so
+// the unregister callback can remove it again.  The trampoline then queues the event
+// just like a generated callback does.  No UObject, no GC root and no ProcessEvent()
+// per event.  Listeners are pooled by SkookumScriptListenerManager.
+//
+// Generated dynamic delegate events cannot bind a trampoline directly, so their register
+// callback hooks the listener up to a shared USkookumScriptListener dispatcher instead.
+class SKOOKUMSCRIPTRUNTIME_API SkookumScriptNativeListener : public SkookumScriptListenerBase
+  {
+  public:
+
+  // Types
+
+    static const uint32_t Slot_idx_none = 0xffffffffu; // m_slot_idx when not in use
+
+    typedef void (*tRegisterCallback)(UObject *, SkookumScriptNativeListener *);
+    typedef void (*tUnregisterCallback)(UObject *, SkookumScriptNativeListener *);
+
+  // Common Methods
+
+    SkookumScriptNativeListener() : m_unregister_callback_p(nullptr), m_slot_idx(Slot_idx_none), m_dispatcher_p(nullptr) {}
+
+  // Methods
+
+    void                    initialize(UObject * obj_p, SkInvokedCoroutine * coro_p, tUnregisterCallback callback_p);
+    void                    deinitialize();
+
+    const FDelegateHandle & get_delegate_handle() const                     { return m_delegate_handle; }
+    void                    set_delegate_handle(const FDelegateHandle & handle) { m_delegate_handle = handle; }
+
+    static bool             coro_on_event_do(SkInvokedCoroutine * scope_p, tRegisterCallback register_f, tUnregisterCallback unregister_f, bool do_until);
+    static bool             coro_wait_event(SkInvokedCoroutine * scope_p, tRegisterCallback register_f, tUnregisterCallback unregister_f);
+
+  protected:
+
+    friend class SkookumScriptListenerManager;
+
+  // Internal Data Members
+
+    TWeakObjectPtr<UObject> m_obj_p;                 // UObject owning the delegate
+    tUnregisterCallback     m_unregister_callback_p; // How to unregister myself from the delegate
+    FDelegateHandle         m_delegate_handle;       // Binding to the delegate
+    uint32_t                m_slot_idx;              // Index in native active list of SkookumScriptListenerManager while in use
+    USkookumScriptListener * m_dispatcher_p;         // Dispatcher feeding this listener if any
+
+  };  // SkookumScriptNativeListener
+
 //---------------------------------------------------------------------------------------
 // Helper class to hold a pointer to a USkookumScriptListener
 // and make sure it gets destroyed when the pointer goes away
@@ -106,9 +329,27 @@ class FSkookumScriptListenerAutoPtr : public TWeakObjectPtr<USkookumScriptListen
     ~FSkookumScriptListenerAutoPtr();
   };
 
+//---------------------------------------------------------------------------------------
+// Helper class to hold a pointer to a SkookumScriptNativeListener
+// and make sure it gets freed when the pointer goes away
+class FSkookumScriptNativeListenerAutoPtr
+  {
+  public:
+
+    FSkookumScriptNativeListenerAutoPtr(SkookumScriptNativeListener * listener_p) : m_listener_p(listener_p) {}
+    ~FSkookumScriptNativeListenerAutoPtr();
+
+    SkookumScriptNativeListener * Get() const { return m_listener_p; }
+
+  protected:
+
+    SkookumScriptNativeListener * m_listener_p;
+  };
+
 //---------------------------------------------------------------------------------------
 // Storage specialization
 template<> inline FSkookumScriptListenerAutoPtr * SkUserDataBase::as<FSkookumScriptListenerAutoPtr>() const { return as_stored<FSkookumScriptListenerAutoPtr>(); }
+template<> inline FSkookumScriptNativeListenerAutoPtr * SkUserDataBase::as<FSkookumScriptNativeListenerAutoPtr>() const { return as_stored<FSkookumScriptNativeListenerAutoPtr>(); }
 
 //=======================================================================================
 // Inline Functions
@@ -116,14 +357,43 @@ template<> inline FSkookumScriptListenerAutoPtr * SkUserDataBase::as<FSkookumScr
 
 //---------------------------------------------------------------------------------------
 
-inline bool USkookumScriptListener::has_event() const
+inline bool FSkookumScriptEventFilter::test_object(const UObject * obj_p)
+  {
+  switch (m_kind)
+    {
+    case Kind_class:  return obj_p && obj_p->IsA(m_class_p);
+    case Kind_object: return obj_p && obj_p == m_object_p.Get();
+    case Kind_none:   return true;
+    default:          return test_unsupported();
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+
+inline bool FSkookumScriptEventFilter::test_scalar(float value)
+  {
+  switch (m_kind)
+    {
+    case Kind_at_least: return value >= m_min_value;
+    case Kind_none:     return true;
+    default:            return test_unsupported();
+    }
+  }
+
+//---------------------------------------------------------------------------------------
+// Class and object filters match either the actor or the component that was hit
+inline bool FSkookumScriptEventFilter::test_hit(const FHitResult & hit)
   {
-  return !m_event_queue.is_empty();
+  if (m_kind == Kind_at_least)
+    {
+    return test_unsupported();
+    }
+  return test_object(hit.GetActor()) || test_object(hit.GetComponent());
   }
 
 //---------------------------------------------------------------------------------------
 
-inline USkookumScriptListener::EventInfo * USkookumScriptListener::pop_event()
+inline bool SkookumScriptListenerBase::has_event() const
   {
-  return m_event_queue.pop_first();
+  return m_payload_count || !m_event_queue.is_empty();
   }
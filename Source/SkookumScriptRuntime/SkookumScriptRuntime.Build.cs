@@ -46,6 +46,7 @@ namespace UnrealBuildTool.Rules
           {
             "Sockets",
             "HTTP",
+            "Json",
             "Networking",
             "NetworkReplayStreaming",
             "Projects",